@@ -7,11 +7,6 @@ SOURCES += main.cpp \
     faceobject.cpp \
     geo3dobject.cpp \
     geo3dobjectset.cpp \
-    occtcylinderobject.cpp \
-    occtdrywellsystem.cpp \
-    occtgeo3dobject.cpp \
-    occtgeo3dobjectset.cpp \
-    occttubeobject.cpp \
     occtviewer.cpp \
     qt3dviewer.cpp
 
@@ -22,57 +17,11 @@ HEADERS += \
     faceobject.h \
     geo3dobject.h \
     geo3dobjectset.h \
-    occtcylinderobject.h \
-    occtdrywellsystem.h \
-    occtgeo3dobject.h \
-    occtgeo3dobjectset.h \
-    occttubeobject.h \
     occtviewer.h \
     qt3dviewer.h
 
-# ========================================
-# OpenCASCADE Configuration
-# ========================================
-
-# Platform-specific paths
-unix:!macx {
-    # Linux - adjust paths based on your installation
-    OCCT_ROOT = /usr/local
-    # Or if installed via package manager:
-    # OCCT_ROOT = /usr
-
-    INCLUDEPATH += $$OCCT_ROOT/include/opencascade
-    LIBS += -L$$OCCT_ROOT/lib
-}
-
-macx {
-    # macOS - adjust paths based on your installation
-    OCCT_ROOT = /usr/local
-
-    INCLUDEPATH += $$OCCT_ROOT/include/opencascade
-    LIBS += -L$$OCCT_ROOT/lib
-}
-
-win32 {
-    # Windows - adjust paths based on your installation
-    OCCT_ROOT = C:/OpenCASCADE-7.7.0
-
-    INCLUDEPATH += $$OCCT_ROOT/inc
-    LIBS += -L$$OCCT_ROOT/win64/vc14/lib
-}
-
-unix:!macx {
-    OCCT_ROOT = /usr/local
-    INCLUDEPATH += $$OCCT_ROOT/include/opencascade
-    LIBS += -L$$OCCT_ROOT/lib
-    QMAKE_RPATHDIR += $$OCCT_ROOT/lib  # ← Important for runtime!
-}
-
-LIBS += -lTKSTEP -lTKSTEPBase -lTKSTEPAttr -lTKXSBase \
-        -lTKernel -lTKMath -lTKBRep -lTKTopAlgo \
-        -lTKPrim -lTKBO -lTKBool -lTKV3d -lTKService -lTKOpenGl
-
-# Additional libraries if using STEP/IGES import/export
-# LIBS += -lTKXSBase -lTKSTEP -lTKIGES
-
+# OpenCASCADE geometry core (tubes, cylinders, drywell system, object set)
+include(drywellcore.pri)
 
+# The interactive viewer additionally needs the OpenGL driver
+include(drywellrender.pri)
@@ -0,0 +1,50 @@
+/**
+ * @file bench_generation.cpp
+ * @brief Thread scaling of OcctDrywellSystem::generateAll()
+ */
+
+#include "benchmarks.h"
+#include "occtdrywellsystem.h"
+
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QThread>
+
+void benchmarkGenerationScaling(int nr, int nz_w, int nz_g)
+{
+    QTextStream out(stdout);
+    out << "== Grid generation scaling: " << nr << " x (" << nz_w << " + " << nz_g << ") = "
+        << nr * (nz_w + nz_g) << " cells ==\n";
+    out << qSetFieldWidth(10) << "threads" << "time [ms]" << "speedup" << "efficiency"
+        << qSetFieldWidth(0) << "\n";
+
+    // 1, 2, 4, ... up to the number of cores (always including the core count)
+    QVector<int> threadCounts;
+    int maxThreads = qMax(1, QThread::idealThreadCount());
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.append(threads);
+    }
+    threadCounts.append(maxThreads);
+
+    qint64 serialMs = 0;
+    for (int threads : threadCounts) {
+        OcctDrywellSystem drywell(0.6f, 4.9f, 7.3f, 20.0f, 43.3f, nr, nz_w, nz_g);
+        drywell.setThreadCount(threads);
+
+        QElapsedTimer timer;
+        timer.start();
+        drywell.generateAll();
+        qint64 elapsedMs = qMax<qint64>(1, timer.elapsed());
+
+        if (threads == 1) {
+            serialMs = elapsedMs;
+        }
+
+        double speedup = static_cast<double>(serialMs) / elapsedMs;
+        out << qSetFieldWidth(10) << threads << elapsedMs
+            << QString::number(speedup, 'f', 2)
+            << QString::number(100.0 * speedup / threads, 'f', 0) + "%"
+            << qSetFieldWidth(0) << "\n";
+        out.flush();
+    }
+}
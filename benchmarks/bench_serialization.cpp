@@ -0,0 +1,152 @@
+/**
+ * @file bench_serialization.cpp
+ * @brief JSON versus binary save/load of OcctGeo3DObjectSet
+ */
+
+#include "benchmarks.h"
+#include "occtgeo3dobjectset.h"
+#include "occttubeobject.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include <cstring>
+#include <functional>
+
+namespace {
+
+// Tubes with distinct dimensions, transforms and colours so nothing compresses away
+OcctGeo3DObjectSet* makeObjectSet(int objectCount)
+{
+    OcctGeo3DObjectSet* objectSet = new OcctGeo3DObjectSet();
+    for (int k = 0; k < objectCount; ++k) {
+        float innerRadius = 0.01f * (k % 100);
+        OcctTubeObject* tube = new OcctTubeObject(innerRadius, innerRadius + 0.01f, 0.1f + 0.001f * (k % 37));
+        tube->setPosition(0.0f, 0.0f, -0.1f * (k / 100));
+        tube->setDiffuseColor(QColor::fromHsv(k % 360, 200, 220));
+        tube->setOpacity(0.5f + 0.5f * (k % 2));
+        objectSet->addObject(QString("Tube_%1").arg(k), tube);
+    }
+    return objectSet;
+}
+
+template <typename T>
+void patch(QByteArray& bytes, int offset, T value)
+{
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+// Damages the header of a valid binary file in ways that must be rejected
+// (offsets follow the FileHeader layout in occtgeo3dobjectset.cpp)
+void checkCorruptBinaryFiles(QTextStream& out, const QString& path)
+{
+    OcctGeo3DObjectSet* objectSet = makeObjectSet(100);
+    bool saved = objectSet->saveToBinaryFile(path);
+    delete objectSet;
+
+    QFile file(path);
+    if (!saved || !file.open(QIODevice::ReadOnly)) {
+        out << "corrupt files: could not write the reference file\n";
+        return;
+    }
+    const QByteArray valid = file.readAll();
+    file.close();
+
+    struct Corruption
+    {
+        const char* name;
+        std::function<void(QByteArray&)> apply;
+    };
+    const Corruption corruptions[] = {
+        { "truncated",             [](QByteArray& b) { b.truncate(b.size() / 2); } },
+        { "object count",          [](QByteArray& b) { patch<quint32>(b, 20, 0xffffffffu); } },
+        { "type table in header",  [](QByteArray& b) { patch<quint64>(b, 24, 8); } },
+        { "wrapping records",      [](QByteArray& b) { patch<quint64>(b, 32, ~quint64(7)); } },
+        { "unaligned records",     [](QByteArray& b) { patch<quint64>(b, 32, 60); } },
+        { "wrapping names size",   [](QByteArray& b) { patch<quint64>(b, 48, ~quint64(0)); } },
+    };
+
+    int rejected = 0;
+    for (const Corruption& corruption : corruptions) {
+        QByteArray bytes = valid;
+        corruption.apply(bytes);
+        if (!file.open(QIODevice::WriteOnly)) {
+            continue;
+        }
+        file.write(bytes);
+        file.close();
+
+        OcctGeo3DObjectSet loaded;
+        if (!loaded.loadFromBinaryFile(path)) {
+            ++rejected;
+        } else {
+            out << "corrupt files: " << corruption.name << " was accepted\n";
+        }
+    }
+
+    out << "corrupt files: " << rejected << " of " << int(sizeof(corruptions) / sizeof(corruptions[0]))
+        << " rejected\n";
+}
+
+} // namespace
+
+void benchmarkSerialization(const QVector<int>& objectCounts)
+{
+    QTextStream out(stdout);
+    out << "== Object set serialization ==\n";
+    out << qSetFieldWidth(10) << "objects" << "format" << "save [ms]" << "load [ms]" << "size [KB]"
+        << qSetFieldWidth(0) << "\n";
+
+    const QString jsonPath = QDir::temp().filePath("drywell_bench_objects.json");
+    const QString binaryPath = QDir::temp().filePath("drywell_bench_objects.bin");
+
+    for (int objectCount : objectCounts) {
+        OcctGeo3DObjectSet* objectSet = makeObjectSet(objectCount);
+
+        struct Format
+        {
+            const char* name;
+            QString path;
+            bool binary;
+        };
+        const Format formats[] = {
+            { "json",   jsonPath,   false },
+            { "binary", binaryPath, true },
+        };
+
+        for (const Format& format : formats) {
+            QElapsedTimer timer;
+            timer.start();
+            bool saved = format.binary ? objectSet->saveToBinaryFile(format.path)
+                                       : objectSet->saveToFile(format.path);
+            qint64 saveMs = timer.elapsed();
+
+            OcctGeo3DObjectSet loaded;
+            timer.start();
+            bool ok = saved && (format.binary ? loaded.loadFromBinaryFile(format.path)
+                                              : loaded.loadFromFile(format.path));
+            qint64 loadMs = timer.elapsed();
+
+            if (!ok || loaded.count() != objectCount) {
+                out << qSetFieldWidth(10) << objectCount << format.name << "failed"
+                    << qSetFieldWidth(0) << "\n";
+                continue;
+            }
+
+            out << qSetFieldWidth(10) << objectCount << format.name << saveMs << loadMs
+                << QFileInfo(format.path).size() / 1024
+                << qSetFieldWidth(0) << "\n";
+            out.flush();
+        }
+
+        delete objectSet;
+    }
+
+    checkCorruptBinaryFiles(out, binaryPath);
+
+    QFile::remove(jsonPath);
+    QFile::remove(binaryPath);
+}
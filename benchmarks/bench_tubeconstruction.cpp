@@ -0,0 +1,100 @@
+/**
+ * @file bench_tubeconstruction.cpp
+ * @brief Boolean-cut vs. revolved annulus construction benchmark
+ */
+
+#include "benchmarks.h"
+#include "occttubeobject.h"
+
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <BRepCheck_Analyzer.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+// Drywell-like cell dimensions: 100 radial rings of 0.2 m starting at 0.6 m
+const int kRings = 100;
+const float kWellRadius = 0.6f;
+const float kRingWidth = 0.2f;
+const float kCellHeight = 0.25f;
+
+// Number of shapes per run that are checked for validity and volume
+const int kValidationSamples = 50;
+
+struct RunResult
+{
+    qint64 elapsedMs = 0;
+    int invalidShapes = 0;
+    double maxVolumeError = 0.0;
+};
+
+RunResult runConstruction(int cellCount, OcctTubeObject::ConstructionMethod method)
+{
+    RunResult result;
+    int validationStride = qMax(1, cellCount / kValidationSamples);
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 validationNs = 0;
+
+    for (int k = 0; k < cellCount; ++k) {
+        float innerRadius = kWellRadius + (k % kRings) * kRingWidth;
+        float outerRadius = innerRadius + kRingWidth;
+        TopoDS_Shape shape = OcctTubeObject::makeAnnulus(innerRadius, outerRadius,
+                                                         kCellHeight, method);
+
+        if (k % validationStride == 0) {
+            QElapsedTimer validationTimer;
+            validationTimer.start();
+
+            if (shape.IsNull() || !BRepCheck_Analyzer(shape).IsValid()) {
+                ++result.invalidShapes;
+            } else {
+                GProp_GProps props;
+                BRepGProp::VolumeProperties(shape, props);
+                double expected = M_PI * (outerRadius * outerRadius - innerRadius * innerRadius) * kCellHeight;
+                double error = std::abs(props.Mass() - expected) / expected;
+                result.maxVolumeError = qMax(result.maxVolumeError, error);
+            }
+
+            validationNs += validationTimer.nsecsElapsed();
+        }
+    }
+
+    // Validation is not part of the construction cost
+    result.elapsedMs = (timer.nsecsElapsed() - validationNs) / 1000000;
+    return result;
+}
+
+} // namespace
+
+void benchmarkTubeConstruction(const QVector<int>& cellCounts)
+{
+    QTextStream out(stdout);
+    out << "== Tube construction: BooleanCut vs Revolved ==\n";
+    out << qSetFieldWidth(10) << "cells" << "cut [ms]" << "revol [ms]" << "speedup"
+        << qSetFieldWidth(0) << "  validation\n";
+
+    for (int cellCount : cellCounts) {
+        RunResult cut = runConstruction(cellCount, OcctTubeObject::BooleanCut);
+        RunResult revolved = runConstruction(cellCount, OcctTubeObject::Revolved);
+
+        double speedup = revolved.elapsedMs > 0
+                             ? static_cast<double>(cut.elapsedMs) / revolved.elapsedMs
+                             : 0.0;
+
+        out << qSetFieldWidth(10) << cellCount << cut.elapsedMs << revolved.elapsedMs
+            << QString::number(speedup, 'f', 1) << qSetFieldWidth(0)
+            << "  invalid " << cut.invalidShapes << "/" << revolved.invalidShapes
+            << ", max volume error " << QString::number(qMax(cut.maxVolumeError, revolved.maxVolumeError), 'e', 2)
+            << "\n";
+        out.flush();
+    }
+}
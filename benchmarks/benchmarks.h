@@ -0,0 +1,45 @@
+/**
+ * @file benchmarks.h
+ * @brief Declarations of the drywell performance benchmarks
+ */
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <QVector>
+
+/**
+ * @brief Compares the Boolean-cut and revolved annulus constructions
+ *
+ * Builds cellCounts[k] tubes with each OcctTubeObject::ConstructionMethod,
+ * reports the wall-clock time per method and validates a sample of the
+ * results (BRepCheck_Analyzer and analytic volume).
+ *
+ * @param cellCounts Number of tubes to build per run (e.g. 1k, 10k, 100k)
+ */
+void benchmarkTubeConstruction(const QVector<int>& cellCounts);
+
+/**
+ * @brief Measures OcctDrywellSystem::generateAll() from 1 to N threads
+ *
+ * Runs generation with 1, 2, 4, ... threads up to QThread::idealThreadCount()
+ * and reports wall-clock time, speedup and parallel efficiency.
+ *
+ * @param nr Number of radial cells
+ * @param nz_w Number of vertical cells in the aggregate zone
+ * @param nz_g Number of vertical cells below the well
+ */
+void benchmarkGenerationScaling(int nr, int nz_w, int nz_g);
+
+/**
+ * @brief Compares JSON and binary save/load of an object set
+ *
+ * Saves and reloads objectCounts[k] tubes with OcctGeo3DObjectSet::saveToFile()
+ * and saveToBinaryFile() and reports the times and file sizes. Finally checks
+ * that binary files with a truncated or corrupted header are rejected.
+ *
+ * @param objectCounts Number of objects per run (e.g. 10k, 100k)
+ */
+void benchmarkSerialization(const QVector<int>& objectCounts);
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,22 @@
+# ========================================
+# Drywell performance benchmarks (console, no widgets)
+# ========================================
+#
+# Usage: drywell_benchmarks [name ...]
+# Without arguments every benchmark is run.
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = drywell_benchmarks
+
+SOURCES += main.cpp \
+    bench_generation.cpp \
+    bench_serialization.cpp \
+    bench_tubeconstruction.cpp
+
+HEADERS += \
+    benchmarks.h
+
+include(../drywellcore.pri)
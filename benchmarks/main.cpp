@@ -0,0 +1,33 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of the drywell benchmark runner
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include "benchmarks.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Benchmarks to run are given by name; none means all
+    QStringList selected = app.arguments().mid(1);
+    auto enabled = [&selected](const QString& name) {
+        return selected.isEmpty() || selected.contains(name);
+    };
+
+    if (enabled("tubes")) {
+        benchmarkTubeConstruction({1000, 10000, 100000});
+    }
+
+    if (enabled("generation")) {
+        benchmarkGenerationScaling(100, 40, 110);
+    }
+
+    if (enabled("serialization")) {
+        benchmarkSerialization({10000, 100000});
+    }
+
+    return 0;
+}
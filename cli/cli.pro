@@ -0,0 +1,17 @@
+# ========================================
+# Drywell command-line batch tool (console, no widgets)
+# ========================================
+#
+# Usage: drywell_cli [--config params.json] [--nr N ...] [--step out.step] [--json out.json]
+# Run with --help for all options. OpenGL is only initialised for --render.
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = drywell_cli
+
+SOURCES += main.cpp
+
+include(../drywellcore.pri)
+include(../drywellrender.pri)
@@ -0,0 +1,402 @@
+/**
+ * @file main.cpp
+ * @brief Headless batch tool: generate a drywell system and export it
+ *
+ * Runs on render-less compute nodes: only QCoreApplication is created and
+ * nothing initialises a window system or OpenGL unless --render is given,
+ * which renders standard views offscreen (see OcctOffscreenRenderer).
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QVector>
+#include <QPair>
+#include <QSize>
+#include <QStringList>
+#include <cmath>
+#include <limits>
+#include "occtdrywellsystem.h"
+#include "occtgeo3dobjectset.h"
+#include "occtoffscreenrenderer.h"
+
+namespace {
+
+const double kFeet = 0.3048;
+
+// Parameter keys as written by OcctDrywellSystem::toJson(), with their options
+struct Parameter
+{
+    const char* key;
+    const char* option;
+    const char* description;
+    double defaultValue;
+    bool isCount;       // Positive integer, otherwise a positive length
+};
+
+const Parameter kParameters[] = {
+    { "wellRadius",         "well-radius",       "Well radius R_w",                      2.0 * kFeet,   false },
+    { "chamberDepth",       "chamber-depth",     "Depth to top of aggregate zone D_c",   16.0 * kFeet,  false },
+    { "aggregateDepth",     "aggregate-depth",   "Aggregate zone thickness D_a",         24.0 * kFeet,  false },
+    { "domainRadius",       "domain-radius",     "Domain radius R_d",                    20.0,          false },
+    { "depthToGroundwater", "groundwater-depth", "Depth to groundwater",                 142.0 * kFeet, false },
+    { "nr",                 "nr",                "Radial cells",                         12,            true },
+    { "nz_w",               "nz-w",              "Vertical cells in the aggregate zone", 12,            true },
+    { "nz_g",               "nz-g",              "Vertical cells below the well",        30,            true },
+};
+
+// Rejects parameters that would divide by zero or give an empty or
+// inverted grid; error names the first offending parameter
+bool validateParameters(const QJsonObject& params, QString& error)
+{
+    for (const Parameter& parameter : kParameters) {
+        const QJsonValue value = params[parameter.key];
+        const double number = value.toDouble();
+        if (!value.isDouble() || !std::isfinite(number) || number <= 0.0) {
+            error = QString("%1 must be a positive number").arg(parameter.key);
+            return false;
+        }
+        if (parameter.isCount && (number != std::floor(number) || number > std::numeric_limits<int>::max())) {
+            error = QString("%1 must be a whole number of cells").arg(parameter.key);
+            return false;
+        }
+    }
+
+    if (params["domainRadius"].toDouble() <= params["wellRadius"].toDouble()) {
+        error = "domainRadius must be larger than wellRadius";
+        return false;
+    }
+    if (params["depthToGroundwater"].toDouble()
+        <= params["chamberDepth"].toDouble() + params["aggregateDepth"].toDouble()) {
+        error = "depthToGroundwater must be below the aggregate zone (chamberDepth + aggregateDepth)";
+        return false;
+    }
+    return true;
+}
+
+// Parses "1920x1080,800x600"
+bool parseSizes(const QString& text, QVector<QSize>& sizes)
+{
+    for (const QString& item : text.split(',', Qt::SkipEmptyParts)) {
+        QStringList parts = item.trimmed().split('x');
+        bool okWidth = false;
+        bool okHeight = false;
+        QSize size = (parts.size() == 2) ? QSize(parts[0].toInt(&okWidth), parts[1].toInt(&okHeight)) : QSize();
+        if (!okWidth || !okHeight || size.isEmpty()) {
+            return false;
+        }
+        sizes.append(size);
+    }
+    return !sizes.isEmpty();
+}
+
+// One row per cell, columns of OcctDrywellSystem::CellTable
+bool writeCellTable(const QString& filePath, const OcctDrywellSystem::CellTable& table)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream << "zone,r_inner,r_outer,z_top,z_bottom,volume,area_inner,area_outer,area_horizontal,"
+              "r_centroid,z_centroid,distance_outer,distance_lower\n";
+    for (int row = 0; row < table.size(); ++row) {
+        stream << int(table.zone[row]) << ',' << table.innerRadius[row] << ',' << table.outerRadius[row] << ','
+               << table.zTop[row] << ',' << table.zBottom[row] << ',' << table.volume[row] << ','
+               << table.innerArea[row] << ',' << table.outerArea[row] << ',' << table.horizontalArea[row] << ','
+               << table.centroidRadius[row] << ',' << table.centroidZ[row] << ','
+               << table.outerDistance[row] << ',' << table.lowerDistance[row] << '\n';
+    }
+    return stream.status() == QTextStream::Ok;
+}
+
+// One row per edge in CSR order; node ids >= cellCount are the well cylinders
+bool writeCellGraph(const QString& filePath, const OcctDrywellSystem::CellGraph& graph)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream << "# cells=" << graph.cellCount << " nodes=" << graph.nodeCount()
+           << " (chamber, aggregate well, below well)\n";
+    stream << "from,to,type,area,distance\n";
+    for (int node = 0; node < graph.nodeCount(); ++node) {
+        for (int edge = graph.rowOffsets[node]; edge < graph.rowOffsets[node + 1]; ++edge) {
+            stream << node << ',' << graph.columns[edge] << ',' << int(graph.type[edge]) << ','
+                   << graph.area[edge] << ',' << graph.distance[edge] << '\n';
+        }
+    }
+    return stream.status() == QTextStream::Ok;
+}
+
+// Written to a temporary file and renamed on success, so a full disk never
+// leaves a truncated file behind
+bool writeJsonFile(const QString& filePath, const QJsonObject& json)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const QByteArray data = QJsonDocument(json).toJson();
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("drywell_cli");
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates a drywell grid and exports it without a GUI.");
+    parser.addHelpOption();
+
+    QCommandLineOption configOption("config", "Read parameters from a JSON file (keys as in the system JSON).", "file");
+    QCommandLineOption threadsOption("threads", "Generation worker threads (0 = all cores).", "n", "0");
+    QCommandLineOption stepOption("step", "Export all solids to a STEP file.", "file");
+    QCommandLineOption jsonOption("json", "Save the object set with OcctGeo3DObjectSet::saveToFile().", "file");
+    QCommandLineOption cellsOption("cells", "Write the cell table (geometry per cell) as CSV.", "file");
+    QCommandLineOption graphOption("graph", "Write the cell adjacency (CSR edges, wells last) as CSV.", "file");
+    QCommandLineOption systemOption("system-json", "Save the system in parametric form (OcctDrywellSystem::toCompactJson()).", "file");
+    QCommandLineOption timingsOption("timings", "Write the timings to a JSON file.", "file");
+    QCommandLineOption renderOption("render", "Render PNGs offscreen to <prefix>_<view>_<w>x<h>.png.", "prefix");
+    QCommandLineOption viewsOption("views", "Camera presets to render (iso, top, section).", "list", "iso,top,section");
+    QCommandLineOption sizesOption("sizes", "Image sizes to render, e.g. 1920x1080,800x600.", "list", "1920x1080");
+    parser.addOption(configOption);
+    parser.addOption(threadsOption);
+    parser.addOption(stepOption);
+    parser.addOption(jsonOption);
+    parser.addOption(cellsOption);
+    parser.addOption(graphOption);
+    parser.addOption(systemOption);
+    parser.addOption(timingsOption);
+    parser.addOption(renderOption);
+    parser.addOption(viewsOption);
+    parser.addOption(sizesOption);
+
+    QVector<QCommandLineOption> parameterOptions;
+    for (const Parameter& parameter : kParameters) {
+        parameterOptions.append(QCommandLineOption(parameter.option, parameter.description, "value"));
+        parser.addOption(parameterOptions.last());
+    }
+
+    parser.process(app);
+
+    // Defaults, then the config file, then explicit options
+    QJsonObject params;
+    for (const Parameter& parameter : kParameters) {
+        params[parameter.key] = parameter.defaultValue;
+    }
+
+    if (parser.isSet(configOption)) {
+        QFile file(parser.value(configOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            err << "Cannot open config file " << file.fileName() << Qt::endl;
+            return 1;
+        }
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+        if (!doc.isObject()) {
+            err << "Invalid config file " << file.fileName() << ": " << error.errorString() << Qt::endl;
+            return 1;
+        }
+        QJsonObject config = doc.object();
+        for (const Parameter& parameter : kParameters) {
+            if (config.contains(parameter.key)) {
+                params[parameter.key] = config[parameter.key];
+            }
+        }
+    }
+
+    for (int k = 0; k < parameterOptions.size(); ++k) {
+        if (parser.isSet(parameterOptions[k])) {
+            bool ok = false;
+            double value = parser.value(parameterOptions[k]).toDouble(&ok);
+            if (!ok) {
+                err << "Invalid value for --" << kParameters[k].option << Qt::endl;
+                return 1;
+            }
+            params[kParameters[k].key] = value;
+        }
+    }
+
+    QString parameterError;
+    if (!validateParameters(params, parameterError)) {
+        err << "Invalid parameters: " << parameterError << Qt::endl;
+        return 1;
+    }
+
+    // Render jobs are validated before any work is done
+    QVector<OcctOffscreenRenderer::RenderJob> renderJobs;
+    if (parser.isSet(renderOption)) {
+        QVector<QSize> sizes;
+        if (!parseSizes(parser.value(sizesOption), sizes)) {
+            err << "Invalid --sizes " << parser.value(sizesOption) << Qt::endl;
+            return 1;
+        }
+        for (const QString& name : parser.value(viewsOption).split(',', Qt::SkipEmptyParts)) {
+            OcctOffscreenRenderer::CameraPreset preset;
+            if (!OcctOffscreenRenderer::presetFromName(name, preset)) {
+                err << "Unknown view " << name << Qt::endl;
+                return 1;
+            }
+            for (const QSize& size : sizes) {
+                renderJobs.append({preset, size.width(), size.height(),
+                                   QString("%1_%2_%3x%4.png")
+                                       .arg(parser.value(renderOption),
+                                            OcctOffscreenRenderer::presetName(preset))
+                                       .arg(size.width())
+                                       .arg(size.height())});
+            }
+        }
+    }
+
+    // Named timings in the order they were taken, in milliseconds
+    QVector<QPair<QString, double>> timings;
+    auto elapsedMs = [](const QElapsedTimer& timer) { return timer.nsecsElapsed() / 1.0e6; };
+    timings.append({"startup", elapsedMs(totalTimer)});
+
+    OcctDrywellSystem drywell(params["wellRadius"].toDouble(),
+                              params["chamberDepth"].toDouble(),
+                              params["aggregateDepth"].toDouble(),
+                              params["domainRadius"].toDouble(),
+                              params["depthToGroundwater"].toDouble(),
+                              params["nr"].toInt(),
+                              params["nz_w"].toInt(),
+                              params["nz_g"].toInt());
+    drywell.setThreadCount(parser.value(threadsOption).toInt());
+
+    QElapsedTimer timer;
+    timer.start();
+    drywell.generateAll();
+    timings.append({"generate", elapsedMs(timer)});
+
+    bool success = true;
+    OcctGeo3DObjectSet* objectSet = nullptr;
+    if (parser.isSet(stepOption) || parser.isSet(jsonOption)) {
+        timer.start();
+        objectSet = drywell.createObjectSet();
+        timings.append({"objectSet", elapsedMs(timer)});
+    }
+
+    if (parser.isSet(stepOption)) {
+        timer.start();
+        if (!objectSet->exportToSTEP(parser.value(stepOption))) {
+            err << "STEP export failed: " << parser.value(stepOption) << Qt::endl;
+            success = false;
+        }
+        timings.append({"exportStep", elapsedMs(timer)});
+    }
+
+    if (parser.isSet(jsonOption)) {
+        timer.start();
+        if (!objectSet->saveToFile(parser.value(jsonOption))) {
+            err << "Saving object set failed: " << parser.value(jsonOption) << Qt::endl;
+            success = false;
+        }
+        timings.append({"saveJson", elapsedMs(timer)});
+    }
+
+    if (parser.isSet(cellsOption)) {
+        // Needs no tube objects, only the parameters
+        timer.start();
+        if (!writeCellTable(parser.value(cellsOption), drywell.getCellTable())) {
+            err << "Writing cell table failed: " << parser.value(cellsOption) << Qt::endl;
+            success = false;
+        }
+        timings.append({"cellTable", elapsedMs(timer)});
+
+        timer.start();
+        double volumeError = drywell.verifyCellTable();
+        timings.append({"cellCheck", elapsedMs(timer)});
+        out << "Cell volumes vs BRepGProp: max relative error " << volumeError << Qt::endl;
+    }
+
+    if (parser.isSet(graphOption)) {
+        timer.start();
+        const OcctDrywellSystem::CellGraph& graph = drywell.getCellGraph();
+        timings.append({"cellGraph", elapsedMs(timer)});
+        out << "Graph: " << graph.nodeCount() << " nodes, " << graph.edgeCount() << " edges" << Qt::endl;
+        if (!writeCellGraph(parser.value(graphOption), graph)) {
+            err << "Writing cell graph failed: " << parser.value(graphOption) << Qt::endl;
+            success = false;
+        }
+    }
+
+    if (parser.isSet(systemOption)) {
+        timer.start();
+        if (!writeJsonFile(parser.value(systemOption), drywell.toCompactJson())) {
+            err << "Saving system failed: " << parser.value(systemOption) << Qt::endl;
+            success = false;
+        }
+        timings.append({"saveSystem", elapsedMs(timer)});
+    }
+
+    if (!renderJobs.isEmpty()) {
+        // One viewer and context for every image
+        timer.start();
+        OcctOffscreenRenderer renderer;
+        if (!renderer.initialize()) {
+            err << "Offscreen rendering is not available (no display?)" << Qt::endl;
+            success = false;
+        } else {
+            drywell.displayGridInContext(renderer.getContext());
+            timings.append({"renderSetup", elapsedMs(timer)});
+
+            timer.start();
+            int written = renderer.renderBatch(renderJobs);
+            timings.append({"render", elapsedMs(timer)});
+            out << "Images: " << written << " of " << renderJobs.size() << " written" << Qt::endl;
+            success = success && (written == renderJobs.size());
+        }
+    }
+
+    delete objectSet;
+    timings.append({"total", elapsedMs(totalTimer)});
+
+    // Report
+    out << "Cells: " << drywell.getTubeCount()
+        << " (nr=" << drywell.getNr() << ", nz_w=" << drywell.getNzW()
+        << ", nz_g=" << drywell.getNzG() << ")" << Qt::endl;
+
+    QJsonObject timingsJson;
+    for (const auto& timing : timings) {
+        out << qSetFieldWidth(12) << Qt::left << timing.first
+            << qSetFieldWidth(10) << Qt::right << QString::number(timing.second, 'f', 1)
+            << qSetFieldWidth(0) << " ms" << Qt::endl;
+        timingsJson[timing.first] = timing.second;
+    }
+
+    if (parser.isSet(timingsOption)) {
+        QJsonObject report;
+        report["parameters"] = params;
+        report["threads"] = parser.value(threadsOption).toInt();
+        report["cells"] = drywell.getTubeCount();
+        report["timingsMs"] = timingsJson;
+        if (!writeJsonFile(parser.value(timingsOption), report)) {
+            err << "Writing timings failed: " << parser.value(timingsOption) << Qt::endl;
+            success = false;
+        }
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,38 @@
+# ========================================
+# Drywell core (OpenCASCADE geometry, no widgets)
+# ========================================
+#
+# Shared by the viewer application and the console targets
+# (benchmarks). Include with: include(path/to/drywellcore.pri)
+
+QT += core gui concurrent
+
+CONFIG += c++17
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/occtcolormap.cpp \
+    $$PWD/occtcylinderobject.cpp \
+    $$PWD/occtdrywellsystem.cpp \
+    $$PWD/occtfieldanimator.cpp \
+    $$PWD/occtgeo3dobject.cpp \
+    $$PWD/occtgeo3dobjectset.cpp \
+    $$PWD/occtgridpresentation.cpp \
+    $$PWD/occtshapecache.cpp \
+    $$PWD/occttubemesher.cpp \
+    $$PWD/occttubeobject.cpp
+
+HEADERS += \
+    $$PWD/occtcolormap.h \
+    $$PWD/occtcylinderobject.h \
+    $$PWD/occtdrywellsystem.h \
+    $$PWD/occtfieldanimator.h \
+    $$PWD/occtgeo3dobject.h \
+    $$PWD/occtgeo3dobjectset.h \
+    $$PWD/occtgridpresentation.h \
+    $$PWD/occtshapecache.h \
+    $$PWD/occttubemesher.h \
+    $$PWD/occttubeobject.h
+
+include($$PWD/occt.pri)
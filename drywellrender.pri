@@ -0,0 +1,18 @@
+# ========================================
+# Drywell rendering (OpenGL driver, no widgets)
+# ========================================
+#
+# Offscreen rendering of standard views; needs drywellcore.pri as well.
+# Include with: include(path/to/drywellrender.pri)
+
+QT += gui
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/occtoffscreenrenderer.cpp
+
+HEADERS += \
+    $$PWD/occtoffscreenrenderer.h
+
+LIBS += -lTKOpenGl
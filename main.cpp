@@ -6,6 +6,7 @@
 #include <QApplication>
 #include "occtviewer.h"
 #include "occtdrywellsystem.h"
+#include "occtfieldanimator.h"
 
 int main(int argc, char *argv[])
 {
@@ -32,6 +33,26 @@ int main(int argc, char *argv[])
     // Create viewer and display
     OcctViewer viewer;
     viewer.setObjectSet(drywell->createObjectSet());
+    viewer.setDrywellSystem(drywell);
+
+    // Synthetic wetting front spreading from the well, for playback
+    int nr = drywell->getNr();
+    int nz_w = drywell->getNzW();
+    int nz_g = drywell->getNzG();
+    viewer.getFieldAnimator()->setTimeSeries(
+        200,
+        [nr, nz_w, nz_g](int frame, QVector<float>& aggregate, QVector<float>& belowWell) {
+            float front = 1.0f + 0.15f * frame;  // Reach of the front in cells
+            for (int i = 0; i < nr; ++i) {
+                for (int j = 0; j < nz_w; ++j) {
+                    aggregate[i * nz_w + j] = qBound(0.0f, 1.0f - i / front, 1.0f);
+                }
+                for (int j = 0; j < nz_g; ++j) {
+                    belowWell[i * nz_g + j] = qBound(0.0f, 1.0f - (i + j) / front, 1.0f);
+                }
+            }
+            return true;
+        });
     viewer.resize(1200, 800);
     viewer.setWindowTitle("Drywell System - Simple Example");
     viewer.show();
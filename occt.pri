@@ -0,0 +1,38 @@
+# ========================================
+# OpenCASCADE Configuration
+# ========================================
+
+# Platform-specific paths
+unix:!macx {
+    # Linux - adjust paths based on your installation
+    OCCT_ROOT = /usr/local
+    # Or if installed via package manager:
+    # OCCT_ROOT = /usr
+
+    INCLUDEPATH += $$OCCT_ROOT/include/opencascade
+    LIBS += -L$$OCCT_ROOT/lib
+    QMAKE_RPATHDIR += $$OCCT_ROOT/lib  # ← Important for runtime!
+}
+
+macx {
+    # macOS - adjust paths based on your installation
+    OCCT_ROOT = /usr/local
+
+    INCLUDEPATH += $$OCCT_ROOT/include/opencascade
+    LIBS += -L$$OCCT_ROOT/lib
+}
+
+win32 {
+    # Windows - adjust paths based on your installation
+    OCCT_ROOT = C:/OpenCASCADE-7.7.0
+
+    INCLUDEPATH += $$OCCT_ROOT/inc
+    LIBS += -L$$OCCT_ROOT/win64/vc14/lib
+}
+
+LIBS += -lTKSTEP -lTKSTEPBase -lTKSTEPAttr -lTKXSBase \
+        -lTKernel -lTKMath -lTKBRep -lTKTopAlgo \
+        -lTKPrim -lTKBO -lTKBool -lTKV3d -lTKService
+
+# Additional libraries if using STEP/IGES import/export
+# LIBS += -lTKXSBase -lTKSTEP -lTKIGES
@@ -0,0 +1,126 @@
+/**
+ * @file occtcolormap.cpp
+ * @brief Implementation of the OcctColorMap class
+ */
+
+#include "occtcolormap.h"
+
+#include <QDebug>
+
+#include <cmath>
+
+OcctColorMap::OcctColorMap(Preset preset, float minimum, float maximum, int tableSize)
+    : m_nanColor(128, 128, 128, 255)
+    , m_minimum(minimum)
+    , m_maximum(maximum)
+    , m_scale(0.0f)
+{
+    setPreset(preset, tableSize);
+}
+
+void OcctColorMap::setControlColors(const QVector<QColor>& colors, int tableSize)
+{
+    if (colors.size() < 2) {
+        qWarning() << "OcctColorMap: at least two control colours are required";
+        return;
+    }
+
+    tableSize = qMax(2, tableSize);
+    m_table.resize(tableSize);
+
+    const int segments = colors.size() - 1;
+    for (int k = 0; k < tableSize; ++k) {
+        // Position along the control colours, split into segment and fraction
+        float t = static_cast<float>(k) / (tableSize - 1) * segments;
+        int segment = qMin(static_cast<int>(t), segments - 1);
+        float f = t - segment;
+
+        const QColor& a = colors[segment];
+        const QColor& b = colors[segment + 1];
+        m_table[k] = Graphic3d_Vec4ub(
+            static_cast<Standard_Byte>(std::lround(a.red() + f * (b.red() - a.red()))),
+            static_cast<Standard_Byte>(std::lround(a.green() + f * (b.green() - a.green()))),
+            static_cast<Standard_Byte>(std::lround(a.blue() + f * (b.blue() - a.blue()))),
+            255);
+    }
+
+    setRange(m_minimum, m_maximum);
+}
+
+void OcctColorMap::setPreset(Preset preset, int tableSize)
+{
+    setControlColors(presetColors(preset), tableSize);
+}
+
+void OcctColorMap::setRange(float minimum, float maximum)
+{
+    m_minimum = minimum;
+    m_maximum = maximum;
+
+    float span = m_maximum - m_minimum;
+    m_scale = (std::fabs(span) > 0.0f) ? (m_table.size() - 1) / span : 0.0f;
+}
+
+float OcctColorMap::getMinimum() const
+{
+    return m_minimum;
+}
+
+float OcctColorMap::getMaximum() const
+{
+    return m_maximum;
+}
+
+void OcctColorMap::setNanColor(const QColor& color)
+{
+    m_nanColor = Graphic3d_Vec4ub(static_cast<Standard_Byte>(color.red()),
+                                  static_cast<Standard_Byte>(color.green()),
+                                  static_cast<Standard_Byte>(color.blue()),
+                                  255);
+}
+
+int OcctColorMap::getTableSize() const
+{
+    return m_table.size();
+}
+
+Graphic3d_Vec4ub OcctColorMap::map(float value) const
+{
+    if (std::isnan(value)) {
+        return m_nanColor;
+    }
+
+    // Clamp in float: out-of-range or infinite values, or a tiny range with a
+    // huge scale, must not reach the float-to-int conversion. An infinite
+    // value over an empty range (scale 0) gives a NaN position; it takes the
+    // first entry like every other value of that range, explicitly rather
+    // than through the comparison order inside qBound()
+    float position = (value - m_minimum) * m_scale;
+    if (std::isnan(position)) {
+        position = 0.0f;
+    }
+    position = qBound(0.0f, position, static_cast<float>(m_table.size() - 1));
+    return m_table[static_cast<int>(position + 0.5f)];
+}
+
+QColor OcctColorMap::mapToQColor(float value) const
+{
+    Graphic3d_Vec4ub color = map(value);
+    return QColor(color.r(), color.g(), color.b());
+}
+
+QVector<QColor> OcctColorMap::presetColors(Preset preset)
+{
+    switch (preset) {
+    case BlueToRed:
+        return { QColor(59, 76, 192), QColor(221, 221, 221), QColor(180, 4, 38) };
+    case Moisture:
+        return { QColor(222, 196, 140), QColor(150, 190, 120), QColor(60, 140, 190), QColor(20, 50, 140) };
+    case Grayscale:
+        return { QColor(0, 0, 0), QColor(255, 255, 255) };
+    case Viridis:
+    default:
+        return { QColor(68, 1, 84), QColor(59, 82, 139), QColor(33, 145, 140),
+                 QColor(94, 201, 98), QColor(253, 231, 37) };
+    }
+}
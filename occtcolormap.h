@@ -0,0 +1,96 @@
+/**
+ * @file occtcolormap.h
+ * @brief Header file for the OcctColorMap class
+ */
+
+#ifndef OCCTCOLORMAP_H
+#define OCCTCOLORMAP_H
+
+#include <QColor>
+#include <QVector>
+
+#include <Graphic3d_Vec4.hxx>
+
+/**
+ * @class OcctColorMap
+ * @brief Maps scalar values to colours through a fixed-size lookup table
+ *
+ * Used to colour grid cells by a field such as moisture content or pressure
+ * head. Values are scaled linearly from [minimum, maximum] to a table index,
+ * so mapping a value is a multiply and an array read. Values outside the
+ * range are clamped; NaN maps to the NaN colour.
+ */
+class OcctColorMap
+{
+public:
+    /**
+     * @brief Built-in colour schemes
+     */
+    enum Preset {
+        Viridis,    // Perceptually uniform, dark blue to yellow
+        BlueToRed,  // Diverging, e.g. for pressure head around zero
+        Moisture,   // Dry sand to saturated blue
+        Grayscale
+    };
+
+    /**
+     * @brief Constructor
+     * @param preset Colour scheme
+     * @param minimum Value mapped to the first table entry
+     * @param maximum Value mapped to the last table entry
+     * @param tableSize Number of table entries (at least 2)
+     */
+    explicit OcctColorMap(Preset preset = Viridis,
+                          float minimum = 0.0f,
+                          float maximum = 1.0f,
+                          int tableSize = 256);
+
+    /**
+     * @brief Rebuilds the table by interpolating evenly spaced control colours
+     * @param colors At least two control colours, from minimum to maximum
+     * @param tableSize Number of table entries (at least 2)
+     */
+    void setControlColors(const QVector<QColor>& colors, int tableSize = 256);
+
+    /**
+     * @brief Rebuilds the table from one of the built-in schemes
+     */
+    void setPreset(Preset preset, int tableSize = 256);
+
+    /**
+     * @brief Sets the value range covered by the table
+     */
+    void setRange(float minimum, float maximum);
+    float getMinimum() const;
+    float getMaximum() const;
+
+    /**
+     * @brief Sets the colour used for NaN values (e.g. inactive cells)
+     */
+    void setNanColor(const QColor& color);
+
+    int getTableSize() const;
+
+    /**
+     * @brief Maps a value to its table colour
+     * @param value Scalar value
+     * @return RGBA colour, alpha is always opaque
+     */
+    Graphic3d_Vec4ub map(float value) const;
+
+    /**
+     * @brief Maps a value to its table colour as a QColor (for legends)
+     */
+    QColor mapToQColor(float value) const;
+
+private:
+    static QVector<QColor> presetColors(Preset preset);
+
+    QVector<Graphic3d_Vec4ub> m_table;
+    Graphic3d_Vec4ub m_nanColor;
+    float m_minimum;
+    float m_maximum;
+    float m_scale;    // (tableSize - 1) / (maximum - minimum)
+};
+
+#endif // OCCTCOLORMAP_H
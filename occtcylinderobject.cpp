@@ -31,10 +31,8 @@ void OcctCylinderObject::setRadius(float radius)
 {
     if (m_radius != radius) {
         m_radius = radius;
-        // Recreate the shape if AIS object exists
-        if (!getAISShape().IsNull()) {
-            createAISObject();
-        }
+        // Recreate the shape if it was already built
+        rebuildShape();
     }
 }
 
@@ -47,10 +45,8 @@ void OcctCylinderObject::setLength(float length)
 {
     if (m_length != length) {
         m_length = length;
-        // Recreate the shape if AIS object exists
-        if (!getAISShape().IsNull()) {
-            createAISObject();
-        }
+        // Recreate the shape if it was already built
+        rebuildShape();
     }
 }
 
@@ -66,8 +62,8 @@ void OcctCylinderObject::setDimensions(float radius, float length)
         changed = true;
     }
 
-    if (changed && !getAISShape().IsNull()) {
-        createAISObject();
+    if (changed) {
+        rebuildShape();
     }
 }
 
@@ -207,6 +203,22 @@ QString OcctCylinderObject::getObjectType() const
     return "Cylinder";
 }
 
+int OcctCylinderObject::writeDimensions(float* dimensions) const
+{
+    dimensions[0] = m_radius;
+    dimensions[1] = m_length;
+    return 2;
+}
+
+bool OcctCylinderObject::readDimensions(const float* dimensions, int count)
+{
+    if (count < 2) {
+        return false;
+    }
+    setDimensions(dimensions[0], dimensions[1]);
+    return true;
+}
+
 // Static registration
 static bool s_occtCylinderRegistered = []() {
     OcctGeo3DObject::registerObjectType("Cylinder", []() -> OcctGeo3DObject* {
@@ -54,6 +54,10 @@ public:
     bool fromJson(const QJsonObject& json) override;
     QString getObjectType() const override;
 
+    // Binary serialization
+    int writeDimensions(float* dimensions) const override;
+    bool readDimensions(const float* dimensions, int count) override;
+
 protected:
     /**
      * @brief Creates the cylinder shape using OpenCASCADE
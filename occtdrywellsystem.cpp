@@ -7,8 +7,27 @@
 #include "occtgeo3dobjectset.h"
 #include "occtcylinderobject.h"
 #include <QJsonArray>
+#include <QDebug>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+#include <algorithm>
+#include <numeric>
 #include <cmath>
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+// See-through look of the batched grid outside the cutaway view
+const double kGridTransparency = 0.4;
+
+} // namespace
+
 OcctDrywellSystem::OcctDrywellSystem(float wellRadius,
                                      float chamberDepth,
                                      float aggregateDepth,
@@ -25,6 +44,8 @@ OcctDrywellSystem::OcctDrywellSystem(float wellRadius,
     , m_nr(nr)
     , m_nz_w(nz_w)
     , m_nz_g(nz_g)
+    , m_threadCount(0)
+    , m_opaque(false)
     , m_chamberCylinder(nullptr)
     , m_aggregateWellCylinder(nullptr)
     , m_belowWellCylinder(nullptr)
@@ -48,21 +69,16 @@ void OcctDrywellSystem::generateAggregateZone()
     // Reserve space for efficiency
     m_tubes.reserve(m_nr * m_nz_w);
 
-    // Create tubes in nested loops
+    // Create tubes on the worker pool
     // i: radial index (0 to nr-1) - from well to domain boundary
     // j: vertical index (0 to nz_w-1) - from top to bottom of aggregate zone
-    for (int i = 0; i < m_nr; ++i) {
-        for (int j = 0; j < m_nz_w; ++j) {
-            createTube(i, j);
-        }
-    }
+    generateZone(m_tubes, m_tubeArena, m_nz_w, &OcctDrywellSystem::setupTube);
 }
 
 void OcctDrywellSystem::generateBelowWellZone()
 {
     // Clear any existing below-well tubes
-    qDeleteAll(m_belowWellTubes);
-    m_belowWellTubes.clear();
+    releaseZone(m_belowWellTubes, m_belowWellTubeArena);
 
     // Calculate radial and vertical cell sizes
     float dr = (m_domainRadius - m_wellRadius) / m_nr;  // Radial increment
@@ -71,14 +87,10 @@ void OcctDrywellSystem::generateBelowWellZone()
     // Reserve space for efficiency
     m_belowWellTubes.reserve(m_nr * m_nz_g);
 
-    // Create tubes in nested loops
+    // Create tubes on the worker pool
     // i: radial index (0 to nr-1) - from well to domain boundary
     // j: vertical index (0 to nz_g-1) - from top of zone to groundwater
-    for (int i = 0; i < m_nr; ++i) {
-        for (int j = 0; j < m_nz_g; ++j) {
-            createBelowWellTube(i, j);
-        }
-    }
+    generateZone(m_belowWellTubes, m_belowWellTubeArena, m_nz_g, &OcctDrywellSystem::setupBelowWellTube);
 }
 
 void OcctDrywellSystem::generateWellCylinders()
@@ -124,7 +136,107 @@ void OcctDrywellSystem::generateAll()
     generateWellCylinders();
 }
 
-void OcctDrywellSystem::createTube(int radialIndex, int verticalIndex)
+void OcctDrywellSystem::setThreadCount(int threadCount)
+{
+    m_threadCount = qMax(0, threadCount);
+}
+
+int OcctDrywellSystem::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+OcctTubeObject* OcctDrywellSystem::allocateZone(QVector<OcctTubeObject*>& tubes,
+                                                std::unique_ptr<OcctTubeObject[]>& arena, int cellCount)
+{
+    releaseZone(tubes, arena);
+    if (cellCount <= 0) {
+        return nullptr;
+    }
+
+    // One allocation for the whole zone
+    arena.reset(new OcctTubeObject[cellCount]);
+    return arena.get();
+}
+
+void OcctDrywellSystem::releaseZone(QVector<OcctTubeObject*>& tubes, std::unique_ptr<OcctTubeObject[]>& arena)
+{
+    tubes.clear();
+    arena.reset();
+}
+
+void OcctDrywellSystem::generateZone(QVector<OcctTubeObject*>& tubes, std::unique_ptr<OcctTubeObject[]>& arena,
+                                     int nz, CellSetup setupCell)
+{
+    int cellCount = m_nr * nz;
+    OcctTubeObject* cells = allocateZone(tubes, arena, cellCount);
+    if (!cells) {
+        return;
+    }
+
+    // Every cell writes only its own arena entry, in getTubeIndex() order
+    tubes.resize(cellCount);
+    for (int index = 0; index < cellCount; ++index) {
+        tubes[index] = &cells[index];
+    }
+
+    auto buildCell = [this, cells, nz, setupCell](int index) {
+        OcctTubeObject& tube = cells[index];
+        (this->*setupCell)(tube, index / nz, index % nz);
+        tube.buildShape();
+    };
+
+    int threadCount = (m_threadCount > 0) ? m_threadCount : QThread::idealThreadCount();
+    if (threadCount <= 1) {
+        for (int index = 0; index < cellCount; ++index) {
+            buildCell(index);
+        }
+        return;
+    }
+
+    QVector<int> indices(cellCount);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+    QtConcurrent::blockingMap(&pool, indices, buildCell);
+}
+
+QColor OcctDrywellSystem::aggregateCellColor(int radialIndex, int verticalIndex) const
+{
+    // Color scheme for aggregate zone: warm orange/brown tones
+    // Each radial layer has a base hue, with slight variation per vertical cell
+    float baseHue = 0.08f;  // Orange base
+    float hueRange = 0.08f; // Range from orange to brown
+    float radialHue = baseHue + (static_cast<float>(radialIndex) / m_nr) * hueRange;
+
+    // Add slight variation within the layer based on vertical position
+    float verticalVariation = (static_cast<float>(verticalIndex) / m_nz_w) * 0.03f - 0.015f;
+    float finalHue = radialHue + verticalVariation;
+
+    QColor layerColor;
+    layerColor.setHsvF(finalHue, 0.7f, 0.75f);  // Warm, saturated colors
+    return layerColor;
+}
+
+QColor OcctDrywellSystem::belowWellCellColor(int radialIndex, int verticalIndex) const
+{
+    // Color scheme for below-well zone: cool blue/green tones (soil colors)
+    // Each radial layer has a base hue, with slight variation per vertical cell
+    float baseHue = 0.45f;  // Cyan/green base
+    float hueRange = 0.15f; // Range from cyan to green
+    float radialHue = baseHue + (static_cast<float>(radialIndex) / m_nr) * hueRange;
+
+    // Add slight variation within the layer based on vertical position
+    float verticalVariation = (static_cast<float>(verticalIndex) / m_nz_g) * 0.03f - 0.015f;
+    float finalHue = radialHue + verticalVariation;
+
+    QColor layerColor;
+    layerColor.setHsvF(finalHue, 0.5f, 0.65f);  // Cooler, less saturated soil colors
+    return layerColor;
+}
+
+void OcctDrywellSystem::setupTube(OcctTubeObject& tube, int radialIndex, int verticalIndex) const
 {
     // Calculate radial and vertical increments
     float dr = (m_domainRadius - m_wellRadius) / m_nr;
@@ -142,38 +254,24 @@ void OcctDrywellSystem::createTube(int radialIndex, int verticalIndex)
     float z_top = -m_chamberDepth - verticalIndex * dz;
     float z_center = z_top - dz / 2.0f;
 
-    // Create the tube object
-    OcctTubeObject* tube = new OcctTubeObject(innerRadius, outerRadius, height);
+    // Configure the tube object, sharing the ring's prototype shape
+    tube.setDimensions(innerRadius, outerRadius, height);
+    tube.setShapeCache(&m_shapeCache);
 
     // Position the tube (x=0, y=0, z=center position)
     // OpenCASCADE uses Z-axis as vertical by default
-    tube->setPosition(0.0f, 0.0f, z_center);
+    tube.setPosition(0.0f, 0.0f, z_center);
 
-    // Color scheme for aggregate zone: warm orange/brown tones
-    // Each radial layer has a base hue, with slight variation per vertical cell
-    float baseHue = 0.08f;  // Orange base
-    float hueRange = 0.08f; // Range from orange to brown
-    float radialHue = baseHue + (static_cast<float>(radialIndex) / m_nr) * hueRange;
-
-    // Add slight variation within the layer based on vertical position
-    float verticalVariation = (static_cast<float>(verticalIndex) / m_nz_w) * 0.03f - 0.015f;
-    float finalHue = radialHue + verticalVariation;
-
-    QColor layerColor;
-    layerColor.setHsvF(finalHue, 0.7f, 0.75f);  // Warm, saturated colors
-    tube->setDiffuseColor(layerColor);
+    tube.setDiffuseColor(aggregateCellColor(radialIndex, verticalIndex));
 
     // Make it transparent
-    tube->setOpacity(0.6f);
+    tube.setOpacity(0.6f);
 
     // Show edges for better visualization
-    tube->setShowEdges(true);
-
-    // Add to collection
-    m_tubes.append(tube);
+    tube.setShowEdges(true);
 }
 
-void OcctDrywellSystem::createBelowWellTube(int radialIndex, int verticalIndex)
+void OcctDrywellSystem::setupBelowWellTube(OcctTubeObject& tube, int radialIndex, int verticalIndex) const
 {
     // Calculate radial and vertical increments
     float dr = (m_domainRadius - m_wellRadius) / m_nr;
@@ -191,34 +289,20 @@ void OcctDrywellSystem::createBelowWellTube(int radialIndex, int verticalIndex)
     float z_top = -(m_chamberDepth + m_aggregateDepth) - verticalIndex * dz;
     float z_center = z_top - dz / 2.0f;
 
-    // Create the tube object
-    OcctTubeObject* tube = new OcctTubeObject(innerRadius, outerRadius, height);
+    // Configure the tube object, sharing the ring's prototype shape
+    tube.setDimensions(innerRadius, outerRadius, height);
+    tube.setShapeCache(&m_shapeCache);
 
     // Position the tube (x=0, y=0, z=center position)
-    tube->setPosition(0.0f, 0.0f, z_center);
-
-    // Color scheme for below-well zone: cool blue/green tones (soil colors)
-    // Each radial layer has a base hue, with slight variation per vertical cell
-    float baseHue = 0.45f;  // Cyan/green base
-    float hueRange = 0.15f; // Range from cyan to green
-    float radialHue = baseHue + (static_cast<float>(radialIndex) / m_nr) * hueRange;
-
-    // Add slight variation within the layer based on vertical position
-    float verticalVariation = (static_cast<float>(verticalIndex) / m_nz_g) * 0.03f - 0.015f;
-    float finalHue = radialHue + verticalVariation;
+    tube.setPosition(0.0f, 0.0f, z_center);
 
-    QColor layerColor;
-    layerColor.setHsvF(finalHue, 0.5f, 0.65f);  // Cooler, less saturated soil colors
-    tube->setDiffuseColor(layerColor);
+    tube.setDiffuseColor(belowWellCellColor(radialIndex, verticalIndex));
 
     // Make it transparent
-    tube->setOpacity(0.6f);
+    tube.setOpacity(0.6f);
 
     // Show edges for better visualization
-    tube->setShowEdges(true);
-
-    // Add to below-well collection
-    m_belowWellTubes.append(tube);
+    tube.setShowEdges(true);
 }
 
 void OcctDrywellSystem::displayInContext(const Handle(AIS_InteractiveContext)& context)
@@ -251,12 +335,173 @@ void OcctDrywellSystem::displayInContext(const Handle(AIS_InteractiveContext)& c
     context->UpdateCurrentViewer();
 }
 
+void OcctDrywellSystem::displayGridInContext(const Handle(AIS_InteractiveContext)& context)
+{
+    if (context.IsNull()) {
+        return;
+    }
+
+    // Well cylinders are only three objects, keep them as regular shapes
+    if (!m_chamberCylinder) {
+        generateWellCylinders();
+    }
+    m_chamberCylinder->displayInContext(context);
+    m_aggregateWellCylinder->displayInContext(context);
+    m_belowWellCylinder->displayInContext(context);
+
+    // Display mode 0 and selection mode 0 are the only ones the grid accepts
+    context->Display(getGridPresentation(), 0, 0, Standard_False);
+
+    context->UpdateCurrentViewer();
+}
+
+Handle(OcctGridPresentation) OcctDrywellSystem::getGridPresentation()
+{
+    if (!m_grid.IsNull()) {
+        return m_grid;
+    }
+
+    float dr = getRadialCellSize();
+    float dzAggregate = getVerticalCellSize();
+    float dzBelow = getBelowWellVerticalCellSize();
+    float zAggregateTop = -m_chamberDepth;
+    float zBelowTop = -(m_chamberDepth + m_aggregateDepth);
+
+    auto toQuantity = [](const QColor& color) {
+        return Quantity_Color(color.redF(), color.greenF(), color.blueF(), Quantity_TOC_RGB);
+    };
+
+    // Cells in the same radial-major order as the tube vectors
+    QVector<OcctGridPresentation::Cell> aggregateCells;
+    aggregateCells.reserve(m_nr * m_nz_w);
+    for (int i = 0; i < m_nr; ++i) {
+        for (int j = 0; j < m_nz_w; ++j) {
+            float zTop = zAggregateTop - j * dzAggregate;
+            aggregateCells.append({m_wellRadius + i * dr, m_wellRadius + (i + 1) * dr,
+                                   zTop, zTop - dzAggregate,
+                                   toQuantity(aggregateCellColor(i, j))});
+        }
+    }
+
+    QVector<OcctGridPresentation::Cell> belowWellCells;
+    belowWellCells.reserve(m_nr * m_nz_g);
+    for (int i = 0; i < m_nr; ++i) {
+        for (int j = 0; j < m_nz_g; ++j) {
+            float zTop = zBelowTop - j * dzBelow;
+            belowWellCells.append({m_wellRadius + i * dr, m_wellRadius + (i + 1) * dr,
+                                   zTop, zTop - dzBelow,
+                                   toQuantity(belowWellCellColor(i, j))});
+        }
+    }
+
+    m_grid = new OcctGridPresentation();
+    m_grid->setZone(OcctGridPresentation::AggregateZone, m_nr, m_nz_w, aggregateCells);
+    m_grid->setZone(OcctGridPresentation::BelowWellZone, m_nr, m_nz_g, belowWellCells);
+
+    // Same see-through look as the individual tubes
+    if (!m_opaque) {
+        m_grid->SetTransparency(kGridTransparency);
+    }
+
+    return m_grid;
+}
+
+bool OcctDrywellSystem::setCellField(OcctGridPresentation::Zone zone,
+                                     const float* values,
+                                     int count,
+                                     const OcctColorMap& colorMap,
+                                     const Handle(AIS_InteractiveContext)& context)
+{
+    if (!getGridPresentation()->setCellField(zone, values, count, colorMap)) {
+        return false;
+    }
+
+    redrawGrid(context);
+    return true;
+}
+
+bool OcctDrywellSystem::setCellColors(OcctGridPresentation::Zone zone,
+                                      const QVector<Graphic3d_Vec4ub>& colors,
+                                      const Handle(AIS_InteractiveContext)& context)
+{
+    if (!getGridPresentation()->setCellColors(zone, colors.constData(), colors.size())) {
+        return false;
+    }
+
+    redrawGrid(context);
+    return true;
+}
+
+void OcctDrywellSystem::redrawGrid(const Handle(AIS_InteractiveContext)& context)
+{
+    // The presentation itself is unchanged, so force the view to redraw
+    if (!context.IsNull()) {
+        context->CurrentViewer()->Invalidate();
+        context->CurrentViewer()->Redraw();
+    }
+}
+
+void OcctDrywellSystem::setOpaque(bool opaque, const Handle(AIS_InteractiveContext)& context)
+{
+    if (m_opaque == opaque) {
+        return;
+    }
+    m_opaque = opaque;
+
+    // A displayed grid goes through the context, which synchronises the
+    // aspects shared with the groups; otherwise Compute() picks it up
+    if (!m_grid.IsNull()) {
+        bool displayed = !context.IsNull() && context->IsDisplayed(m_grid);
+        if (opaque) {
+            if (displayed) {
+                context->UnsetTransparency(m_grid, Standard_False);
+            } else {
+                m_grid->UnsetTransparency();
+            }
+        } else {
+            if (displayed) {
+                context->SetTransparency(m_grid, kGridTransparency, Standard_False);
+            } else {
+                m_grid->SetTransparency(kGridTransparency);
+            }
+        }
+    }
+
+    OcctCylinderObject* cylinders[] = { m_chamberCylinder, m_aggregateWellCylinder, m_belowWellCylinder };
+    if (opaque) {
+        m_savedCylinderOpacities.clear();
+        for (OcctCylinderObject* cylinder : cylinders) {
+            m_savedCylinderOpacities.append(cylinder ? cylinder->getOpacity() : 1.0f);
+            if (cylinder) {
+                cylinder->setOpacity(1.0f);
+            }
+        }
+    } else {
+        for (int k = 0; k < m_savedCylinderOpacities.size(); ++k) {
+            if (cylinders[k]) {
+                cylinders[k]->setOpacity(m_savedCylinderOpacities[k]);
+            }
+        }
+        m_savedCylinderOpacities.clear();
+    }
+}
+
+bool OcctDrywellSystem::isOpaque() const
+{
+    return m_opaque;
+}
+
 void OcctDrywellSystem::eraseFromContext(const Handle(AIS_InteractiveContext)& context)
 {
     if (context.IsNull()) {
         return;
     }
 
+    // Erase the batched grid if it was displayed
+    if (!m_grid.IsNull()) {
+        context->Erase(m_grid, Standard_False);
+    }
+
     // Erase well cylinders
     if (m_chamberCylinder) {
         m_chamberCylinder->eraseFromContext(context);
@@ -294,45 +539,34 @@ void OcctDrywellSystem::addToObjectSet(OcctGeo3DObjectSet* objectSet) const
         return;
     }
 
-    // Add well cylinders
+    // Everything stays owned by this system; the cells live in the zone
+    // arenas and must never be deleted individually
     if (m_chamberCylinder) {
-        objectSet->addObject("well_chamber", m_chamberCylinder);
+        objectSet->addObject("well_chamber", m_chamberCylinder, OcctGeo3DObjectSet::ExternalOwnership);
     }
     if (m_aggregateWellCylinder) {
-        objectSet->addObject("well_aggregate", m_aggregateWellCylinder);
+        objectSet->addObject("well_aggregate", m_aggregateWellCylinder, OcctGeo3DObjectSet::ExternalOwnership);
     }
     if (m_belowWellCylinder) {
-        objectSet->addObject("well_below", m_belowWellCylinder);
+        objectSet->addObject("well_below", m_belowWellCylinder, OcctGeo3DObjectSet::ExternalOwnership);
     }
 
+    // Tubes are added by structured key: no per-cell name string is built,
+    // names such as "tube_r{i}_z{j}" are derived only when asked for
+    objectSet->setZonePrefix(OcctGridPresentation::AggregateZone, "tube_");
+    objectSet->setZonePrefix(OcctGridPresentation::BelowWellZone, "tube_below_");
+    objectSet->reserve(objectSet->count() + m_tubes.size() + m_belowWellTubes.size());
+
     // Add all aggregate zone tubes to the object set
     for (int i = 0; i < m_tubes.size(); ++i) {
-        OcctTubeObject* tube = m_tubes[i];
-
-        // Calculate layer indices
-        int radialIndex = i / m_nz_w;
-        int verticalIndex = i % m_nz_w;
-
-        // Create unique name for each tube
-        QString tubeName = QString("tube_r%1_z%2").arg(radialIndex).arg(verticalIndex);
-
-        // Add tube to object set
-        objectSet->addObject(tubeName, tube);
+        objectSet->addObject(m_tubes[i], {OcctGridPresentation::AggregateZone, i / m_nz_w, i % m_nz_w},
+                             OcctGeo3DObjectSet::ExternalOwnership);
     }
 
     // Add all below-well zone tubes to the object set
     for (int i = 0; i < m_belowWellTubes.size(); ++i) {
-        OcctTubeObject* tube = m_belowWellTubes[i];
-
-        // Calculate layer indices
-        int radialIndex = i / m_nz_g;
-        int verticalIndex = i % m_nz_g;
-
-        // Create unique name for each below-well tube
-        QString tubeName = QString("tube_below_r%1_z%2").arg(radialIndex).arg(verticalIndex);
-
-        // Add tube to object set
-        objectSet->addObject(tubeName, tube);
+        objectSet->addObject(m_belowWellTubes[i], {OcctGridPresentation::BelowWellZone, i / m_nz_g, i % m_nz_g},
+                             OcctGeo3DObjectSet::ExternalOwnership);
     }
 }
 
@@ -383,11 +617,8 @@ int OcctDrywellSystem::getTubeCount() const
 
 void OcctDrywellSystem::clear()
 {
-    qDeleteAll(m_tubes);
-    m_tubes.clear();
-
-    qDeleteAll(m_belowWellTubes);
-    m_belowWellTubes.clear();
+    releaseZone(m_tubes, m_tubeArena);
+    releaseZone(m_belowWellTubes, m_belowWellTubeArena);
 
     delete m_chamberCylinder;
     m_chamberCylinder = nullptr;
@@ -397,6 +628,24 @@ void OcctDrywellSystem::clear()
 
     delete m_belowWellCylinder;
     m_belowWellCylinder = nullptr;
+
+    m_shapeCache.clear();
+
+    // The grid and the cell table are derived from the parameters; rebuilt on
+    // next use. The property column is caller data, kept for fillCellTable()
+    // to reuse if the zone layout is unchanged
+    if (!m_grid.IsNull()) {
+        // Once the handle is dropped the stale grid could no longer be erased
+        if (m_grid->HasInteractiveContext()) {
+            m_grid->GetContext()->Remove(m_grid, Standard_False);
+        }
+        m_grid.Nullify();
+    }
+    CellTable table;
+    table.property.swap(m_cellTable.property);
+    std::copy(std::begin(m_cellTable.zoneSize), std::end(m_cellTable.zoneSize), std::begin(table.zoneSize));
+    m_cellTable = std::move(table);
+    m_cellGraph = CellGraph();
 }
 
 float OcctDrywellSystem::getRadialCellSize() const
@@ -414,6 +663,320 @@ float OcctDrywellSystem::getBelowWellVerticalCellSize() const
     return (m_depthToGroundwater - (m_chamberDepth + m_aggregateDepth)) / m_nz_g;
 }
 
+const OcctDrywellSystem::CellTable& OcctDrywellSystem::getCellTable() const
+{
+    if (m_cellTable.size() == 0) {
+        fillCellTable(m_cellTable);
+    }
+    return m_cellTable;
+}
+
+bool OcctDrywellSystem::setCellProperty(const QVector<float>& values)
+{
+    if (values.size() != getCellTable().size()) {
+        qWarning() << "OcctDrywellSystem: expected" << m_cellTable.size() << "cell values, got" << values.size();
+        return false;
+    }
+    m_cellTable.property = values;
+    return true;
+}
+
+void OcctDrywellSystem::fillCellTable(CellTable& table) const
+{
+    const int nr = qMax(0, m_nr);
+    const int nz[OcctGridPresentation::ZoneCount] = { qMax(0, m_nz_w), qMax(0, m_nz_g) };
+    const float zoneTop[OcctGridPresentation::ZoneCount] = { -m_chamberDepth, -(m_chamberDepth + m_aggregateDepth) };
+    const float dz[OcctGridPresentation::ZoneCount] = { getVerticalCellSize(), getBelowWellVerticalCellSize() };
+    const float dr = getRadialCellSize();
+
+    // A property column left by clear() is kept if every zone has the same size
+    bool keepProperty = true;
+    int rowCount = 0;
+    for (int zone = 0; zone < OcctGridPresentation::ZoneCount; ++zone) {
+        keepProperty = keepProperty && table.zoneSize[zone] == nr * nz[zone];
+        table.zoneBegin[zone] = rowCount;
+        table.zoneSize[zone] = nr * nz[zone];
+        rowCount += table.zoneSize[zone];
+    }
+
+    table.innerRadius.resize(rowCount);
+    table.outerRadius.resize(rowCount);
+    table.zTop.resize(rowCount);
+    table.zBottom.resize(rowCount);
+    table.volume.resize(rowCount);
+    table.zone.resize(rowCount);
+    if (!keepProperty || table.property.size() != rowCount) {
+        table.property.fill(0.0f, rowCount);
+    }
+    table.innerArea.resize(rowCount);
+    table.outerArea.resize(rowCount);
+    table.horizontalArea.resize(rowCount);
+    table.centroidRadius.resize(rowCount);
+    table.centroidZ.resize(rowCount);
+    table.outerDistance.resize(rowCount);
+    table.lowerDistance.resize(rowCount);
+
+    float* innerRadius = table.innerRadius.data();
+    float* outerRadius = table.outerRadius.data();
+    float* zTop = table.zTop.data();
+    float* zBottom = table.zBottom.data();
+    float* volume = table.volume.data();
+    quint8* zoneId = table.zone.data();
+    float* innerArea = table.innerArea.data();
+    float* outerArea = table.outerArea.data();
+    float* horizontalArea = table.horizontalArea.data();
+    float* centroidRadius = table.centroidRadius.data();
+    float* centroidZ = table.centroidZ.data();
+    float* outerDistance = table.outerDistance.data();
+    float* lowerDistance = table.lowerDistance.data();
+
+    const float pi = static_cast<float>(M_PI);
+    auto ringCentroid = [](float ri, float ro) {
+        return (2.0f / 3.0f) * (ro * ro * ro - ri * ri * ri) / (ro * ro - ri * ri);
+    };
+
+    // Straight loops over raw columns with no calls or branches inside,
+    // so the compiler can vectorise them
+    for (int zone = 0; zone < OcctGridPresentation::ZoneCount; ++zone) {
+        const int begin = table.zoneBegin[zone];
+        const int cells = nz[zone];
+        const float top = zoneTop[zone];
+        const float height = dz[zone];
+
+        // Below the last cell of the aggregate zone is the first below-well cell
+        const float lastLowerDistance = (zone == OcctGridPresentation::AggregateZone && nz[OcctGridPresentation::BelowWellZone] > 0)
+                                        ? 0.5f * (height + dz[OcctGridPresentation::BelowWellZone]) : 0.0f;
+
+        for (int i = 0; i < nr; ++i) {
+            const float ri = m_wellRadius + i * dr;
+            const float ro = ri + dr;
+            const float ringArea = pi * (ro * ro - ri * ri);
+            const float rc = ringCentroid(ri, ro);
+            const float rcOuter = (i + 1 < nr) ? ringCentroid(ro, ro + dr) : rc;
+            const int row = begin + i * cells;
+
+            for (int j = 0; j < cells; ++j) {
+                innerRadius[row + j] = ri;
+                outerRadius[row + j] = ro;
+                zTop[row + j] = top - j * height;
+                zBottom[row + j] = top - (j + 1) * height;
+                centroidZ[row + j] = top - (j + 0.5f) * height;
+                volume[row + j] = ringArea * height;
+                zoneId[row + j] = static_cast<quint8>(zone);
+                innerArea[row + j] = 2.0f * pi * ri * height;
+                outerArea[row + j] = 2.0f * pi * ro * height;
+                horizontalArea[row + j] = ringArea;
+                centroidRadius[row + j] = rc;
+                outerDistance[row + j] = rcOuter - rc;
+                lowerDistance[row + j] = height;
+            }
+
+            if (cells > 0) {
+                lowerDistance[row + cells - 1] = lastLowerDistance;
+            }
+        }
+    }
+}
+
+const OcctDrywellSystem::CellGraph& OcctDrywellSystem::getCellGraph() const
+{
+    if (m_cellGraph.rowOffsets.isEmpty()) {
+        fillCellGraph(m_cellGraph);
+    }
+    return m_cellGraph;
+}
+
+void OcctDrywellSystem::fillCellGraph(CellGraph& graph) const
+{
+    const CellTable& table = getCellTable();
+    const int cellCount = table.size();
+    const int nodeCount = cellCount + CellGraph::WellNodeCount;
+    const int nr = qMax(0, m_nr);
+    const int nzW = table.zoneSize[OcctGridPresentation::AggregateZone] > 0 ? m_nz_w : 0;
+    const int nzG = table.zoneSize[OcctGridPresentation::BelowWellZone] > 0 ? m_nz_g : 0;
+    const int aggregateBegin = table.zoneBegin[OcctGridPresentation::AggregateZone];
+    const int belowBegin = table.zoneBegin[OcctGridPresentation::BelowWellZone];
+
+    // Well cylinders are stacked on the axis
+    const float wellArea = static_cast<float>(M_PI) * m_wellRadius * m_wellRadius;
+    const float belowWellHeight = m_depthToGroundwater - (m_chamberDepth + m_aggregateDepth);
+    const float chamberToAggregate = 0.5f * (m_chamberDepth + m_aggregateDepth);
+    const float aggregateToBelow = 0.5f * (m_aggregateDepth + belowWellHeight);
+
+    const int chamberNode = cellCount + CellGraph::ChamberWell;
+    const int aggregateNode = cellCount + CellGraph::AggregateWell;
+    const int belowNode = cellCount + CellGraph::BelowWell;
+
+    // Calls add(neighbour, area, distance, type) for every edge of a node, in
+    // a fixed order; both passes below use it so they always agree
+    auto visitEdges = [&](int node, auto&& add) {
+        if (node >= cellCount) {
+            if (node == chamberNode) {
+                add(aggregateNode, wellArea, chamberToAggregate, CellGraph::WellEdge);
+            } else if (node == aggregateNode) {
+                add(chamberNode, wellArea, chamberToAggregate, CellGraph::WellEdge);
+                add(belowNode, wellArea, aggregateToBelow, CellGraph::WellEdge);
+                for (int cell = aggregateBegin; nr > 0 && cell < aggregateBegin + nzW; ++cell) {
+                    add(cell, table.innerArea[cell], table.centroidRadius[cell] - m_wellRadius, CellGraph::WellEdge);
+                }
+            } else {
+                add(aggregateNode, wellArea, aggregateToBelow, CellGraph::WellEdge);
+                for (int cell = belowBegin; nr > 0 && cell < belowBegin + nzG; ++cell) {
+                    add(cell, table.innerArea[cell], table.centroidRadius[cell] - m_wellRadius, CellGraph::WellEdge);
+                }
+            }
+            return;
+        }
+
+        const bool aggregate = (table.zone[node] == OcctGridPresentation::AggregateZone);
+        const int nz = aggregate ? nzW : nzG;
+        const int index = node - (aggregate ? aggregateBegin : belowBegin);
+        const int i = index / nz;
+        const int j = index % nz;
+
+        // Inner: previous ring, or the well cylinder beside the zone
+        if (i > 0) {
+            add(node - nz, table.innerArea[node], table.outerDistance[node - nz], CellGraph::RadialEdge);
+        } else {
+            add(aggregate ? aggregateNode : belowNode, table.innerArea[node],
+                table.centroidRadius[node] - m_wellRadius, CellGraph::WellEdge);
+        }
+
+        // Outer: next ring
+        if (i + 1 < nr) {
+            add(node + nz, table.outerArea[node], table.outerDistance[node], CellGraph::RadialEdge);
+        }
+
+        // Upper: same zone, or the bottom aggregate cell of the ring
+        if (j > 0) {
+            add(node - 1, table.horizontalArea[node], table.lowerDistance[node - 1], CellGraph::VerticalEdge);
+        } else if (!aggregate && nzW > 0) {
+            int upper = aggregateBegin + i * nzW + nzW - 1;
+            add(upper, table.horizontalArea[node], table.lowerDistance[upper], CellGraph::ZoneBoundaryEdge);
+        }
+
+        // Lower: same zone, or the top below-well cell of the ring
+        if (j + 1 < nz) {
+            add(node + 1, table.horizontalArea[node], table.lowerDistance[node], CellGraph::VerticalEdge);
+        } else if (aggregate && nzG > 0) {
+            add(belowBegin + i * nzG, table.horizontalArea[node], table.lowerDistance[node],
+                CellGraph::ZoneBoundaryEdge);
+        }
+    };
+
+    // Pass 1: edge count per node, prefix-summed into the row offsets
+    graph.cellCount = cellCount;
+    graph.rowOffsets.fill(0, nodeCount + 1);
+    for (int node = 0; node < nodeCount; ++node) {
+        int degree = 0;
+        visitEdges(node, [&degree](int, float, float, CellGraph::EdgeType) { ++degree; });
+        graph.rowOffsets[node + 1] = graph.rowOffsets[node] + degree;
+    }
+
+    // Pass 2: fill the edges in node order
+    const int edgeCount = graph.rowOffsets[nodeCount];
+    graph.columns.resize(edgeCount);
+    graph.area.resize(edgeCount);
+    graph.distance.resize(edgeCount);
+    graph.type.resize(edgeCount);
+
+    int edge = 0;
+    for (int node = 0; node < nodeCount; ++node) {
+        visitEdges(node, [&graph, &edge](int neighbour, float area, float distance, CellGraph::EdgeType type) {
+            graph.columns[edge] = neighbour;
+            graph.area[edge] = area;
+            graph.distance[edge] = distance;
+            graph.type[edge] = static_cast<quint8>(type);
+            ++edge;
+        });
+    }
+}
+
+double OcctDrywellSystem::verifyCellTable(int sampleCount) const
+{
+    const CellTable& table = getCellTable();
+    const int total = qMin(sampleCount, table.size());
+    if (total <= 0) {
+        return -1.0;
+    }
+
+    // Samples per zone: proportional to the zone size and exactly total
+    // overall. Every non-empty zone gets one if there are enough samples;
+    // otherwise the larger zones are preferred
+    int nonEmptyZones = 0;
+    for (int zone = 0; zone < OcctGridPresentation::ZoneCount; ++zone) {
+        nonEmptyZones += (table.zoneSize[zone] > 0) ? 1 : 0;
+    }
+    const int minimum = (total >= nonEmptyZones) ? 1 : 0;
+
+    int quota[OcctGridPresentation::ZoneCount];
+    int assigned = 0;
+    for (int zone = 0; zone < OcctGridPresentation::ZoneCount; ++zone) {
+        const int size = table.zoneSize[zone];
+        quota[zone] = (size > 0) ? qBound(minimum, int(qint64(total) * size / table.size()), size) : 0;
+        assigned += quota[zone];
+    }
+    while (assigned != total) {
+        // Take from the zone with the most samples (the smaller zone on a
+        // tie), give to the one with the fewest that still has room
+        const bool reduce = assigned > total;
+        int pick = -1;
+        for (int zone = 0; zone < OcctGridPresentation::ZoneCount; ++zone) {
+            if (reduce) {
+                if (quota[zone] > minimum
+                    && (pick < 0 || quota[zone] > quota[pick]
+                        || (quota[zone] == quota[pick] && table.zoneSize[zone] < table.zoneSize[pick]))) {
+                    pick = zone;
+                }
+            } else if (quota[zone] < table.zoneSize[zone] && (pick < 0 || quota[zone] < quota[pick])) {
+                pick = zone;
+            }
+        }
+        quota[pick] += reduce ? -1 : 1;
+        assigned += reduce ? -1 : 1;
+    }
+
+    double maxError = -1.0;
+    for (int zone = 0; zone < OcctGridPresentation::ZoneCount; ++zone) {
+        const int nz = (zone == OcctGridPresentation::AggregateZone) ? m_nz_w : m_nz_g;
+
+        // Evenly spread over the zone, from the inner ring to the outer one
+        for (int k = 0; k < quota[zone]; ++k) {
+            const int index = int(qint64(k) * table.zoneSize[zone] / quota[zone]);
+            const int row = table.zoneBegin[zone] + index;
+
+            // Degenerate cells (e.g. domainRadius == wellRadius) have no relative error
+            if (table.volume[row] <= 0.0f) {
+                continue;
+            }
+
+            OcctTubeObject tube;
+            if (zone == OcctGridPresentation::AggregateZone) {
+                setupTube(tube, index / nz, index % nz);
+            } else {
+                setupBelowWellTube(tube, index / nz, index % nz);
+            }
+            tube.buildShape();
+            if (tube.getShape().IsNull()) {
+                continue;
+            }
+
+            GProp_GProps properties;
+            BRepGProp::VolumeProperties(tube.getShape(), properties);
+            double error = std::abs(properties.Mass() - table.volume[row]) / table.volume[row];
+            if (error > maxError) {
+                maxError = error;
+            }
+        }
+    }
+
+    if (maxError > 1.0e-4) {
+        qWarning() << "OcctDrywellSystem: analytic cell volumes differ from BRepGProp by up to"
+                   << maxError * 100.0 << "%";
+    }
+    return maxError;
+}
+
 int OcctDrywellSystem::getTubeIndex(int radialIndex, int verticalIndex) const
 {
     // Tubes are stored in row-major order: for each radial layer, all vertical cells
@@ -462,6 +1025,83 @@ QJsonObject OcctDrywellSystem::toJson() const
     return json;
 }
 
+QJsonObject OcctDrywellSystem::toCompactJson() const
+{
+    QJsonObject json;
+    json["format"] = "parametric";
+    json["version"] = 1;
+
+    // System parameters
+    json["wellRadius"] = m_wellRadius;
+    json["chamberDepth"] = m_chamberDepth;
+    json["aggregateDepth"] = m_aggregateDepth;
+    json["domainRadius"] = m_domainRadius;
+    json["depthToGroundwater"] = m_depthToGroundwater;
+    json["nr"] = m_nr;
+    json["nz_w"] = m_nz_w;
+    json["nz_g"] = m_nz_g;
+
+    // Whether the loader should build tube objects at all
+    json["generated"] = !m_tubes.isEmpty() || !m_belowWellTubes.isEmpty();
+
+    QJsonArray overrides;
+    collectOverrides(overrides, "aggregate", m_tubes, m_nz_w, &OcctDrywellSystem::setupTube);
+    collectOverrides(overrides, "belowWell", m_belowWellTubes, m_nz_g, &OcctDrywellSystem::setupBelowWellTube);
+    json["overrides"] = overrides;
+
+    return json;
+}
+
+void OcctDrywellSystem::collectOverrides(QJsonArray& overrides, const QString& zoneName,
+                                         const QVector<OcctTubeObject*>& tubes, int nz,
+                                         CellSetup setupCell) const
+{
+    if (nz <= 0) {
+        return;
+    }
+
+    for (int index = 0; index < tubes.size(); ++index) {
+        int i = index / nz;
+        int j = index % nz;
+
+        // Compare against the cell as generateAll() would create it
+        OcctTubeObject reference;
+        (this->*setupCell)(reference, i, j);
+        QJsonObject expected = reference.toJson();
+
+        QJsonObject actual = tubes[index]->toJson();
+        QJsonObject properties;
+        for (auto it = actual.constBegin(); it != actual.constEnd(); ++it) {
+            if (it.value() != expected.value(it.key())) {
+                properties[it.key()] = it.value();
+            }
+        }
+
+        if (!properties.isEmpty()) {
+            properties["type"] = actual["type"];
+            overrides.append(QJsonObject{{"zone", zoneName}, {"r", i}, {"z", j},
+                                         {"properties", properties}});
+        }
+    }
+}
+
+bool OcctDrywellSystem::applyOverride(const QJsonObject& entry)
+{
+    QString zone = entry["zone"].toString();
+    int i = entry["r"].toInt(-1);
+    int j = entry["z"].toInt(-1);
+
+    OcctTubeObject* tube = nullptr;
+    if (zone == "aggregate") {
+        tube = getTube(i, j);
+    } else if (zone == "belowWell") {
+        tube = getBelowWellTube(i, j);
+    }
+
+    // Only the properties present in the override are changed
+    return tube && tube->fromJson(entry["properties"].toObject());
+}
+
 bool OcctDrywellSystem::fromJson(const QJsonObject& json)
 {
     // Clear existing tubes
@@ -484,18 +1124,33 @@ bool OcctDrywellSystem::fromJson(const QJsonObject& json)
     m_nz_w = json["nz_w"].toInt();
     m_nz_g = json["nz_g"].toInt();
 
+    // Parametric format: regenerate, then apply the sparse overrides
+    if (json["format"].toString() == "parametric") {
+        if (json["generated"].toBool(true)) {
+            generateAll();
+        }
+
+        const QJsonArray overrides = json["overrides"].toArray();
+        for (const QJsonValue& value : overrides) {
+            if (!applyOverride(value.toObject())) {
+                qWarning() << "OcctDrywellSystem: ignoring invalid cell override" << value;
+            }
+        }
+        return true;
+    }
+
     // Load aggregate zone tubes if they exist
     if (json.contains("tubes")) {
         QJsonArray tubesArray = json["tubes"].toArray();
+        OcctTubeObject* cells = allocateZone(m_tubes, m_tubeArena, tubesArray.size());
         m_tubes.reserve(tubesArray.size());
 
-        for (const QJsonValue& tubeValue : tubesArray) {
-            QJsonObject tubeJson = tubeValue.toObject();
-            OcctTubeObject* tube = new OcctTubeObject();
-            if (tube->fromJson(tubeJson)) {
+        // Entries that fail to load stay unused in the arena
+        for (int k = 0; k < tubesArray.size(); ++k) {
+            OcctTubeObject* tube = &cells[k];
+            tube->setShapeCache(&m_shapeCache);
+            if (tube->fromJson(tubesArray[k].toObject())) {
                 m_tubes.append(tube);
-            } else {
-                delete tube;
             }
         }
     }
@@ -503,15 +1158,15 @@ bool OcctDrywellSystem::fromJson(const QJsonObject& json)
     // Load below-well zone tubes if they exist
     if (json.contains("belowWellTubes")) {
         QJsonArray belowWellTubesArray = json["belowWellTubes"].toArray();
+        OcctTubeObject* cells = allocateZone(m_belowWellTubes, m_belowWellTubeArena, belowWellTubesArray.size());
         m_belowWellTubes.reserve(belowWellTubesArray.size());
 
-        for (const QJsonValue& tubeValue : belowWellTubesArray) {
-            QJsonObject tubeJson = tubeValue.toObject();
-            OcctTubeObject* tube = new OcctTubeObject();
-            if (tube->fromJson(tubeJson)) {
+        // Entries that fail to load stay unused in the arena
+        for (int k = 0; k < belowWellTubesArray.size(); ++k) {
+            OcctTubeObject* tube = &cells[k];
+            tube->setShapeCache(&m_shapeCache);
+            if (tube->fromJson(belowWellTubesArray[k].toObject())) {
                 m_belowWellTubes.append(tube);
-            } else {
-                delete tube;
             }
         }
     }
@@ -8,8 +8,13 @@
 
 #include <QVector>
 #include <QJsonObject>
+#include <QJsonArray>
+#include <memory>
 #include <AIS_InteractiveContext.hxx>
 #include "occttubeobject.h"
+#include "occtshapecache.h"
+#include "occtgridpresentation.h"
+#include "occtcolormap.h"
 
 // Forward declarations
 class OcctGeo3DObjectSet;
@@ -21,10 +26,98 @@ class OcctCylinderObject;
  *
  * The OcctDrywellSystem creates a collection of OcctTubeObjects arranged in a cylindrical
  * grid pattern to represent the aggregate zone of a drywell infiltration system.
+ *
+ * All tubes of one radial ring in a zone have identical dimensions, so they share a
+ * single prototype BRep (see OcctShapeCache) and differ only by their location.
  */
 class OcctDrywellSystem
 {
 public:
+    /**
+     * @brief Geometry of every grid cell as structure-of-arrays
+     *
+     * One row per cell, aggregate zone first (getTubeIndex() order), then the
+     * below-well zone (getBelowWellTubeIndex() order). Each column is a
+     * contiguous array, so solvers and exporters can stream over it without
+     * any OCCT object. Lengths in model units, z negative downwards.
+     *
+     * The metrics a finite-volume solver needs are computed analytically in
+     * the same pass: face areas, centroids and the centroid distances to the
+     * outer and lower neighbours. The below-well zone continues the aggregate
+     * zone downwards, so the lowest aggregate cell of a ring has the top
+     * below-well cell of the same ring as its lower neighbour.
+     */
+    struct CellTable
+    {
+        QVector<float> innerRadius;
+        QVector<float> outerRadius;
+        QVector<float> zTop;
+        QVector<float> zBottom;
+        QVector<float> volume;        // pi * (r_o^2 - r_i^2) * (z_top - z_bottom)
+        QVector<quint8> zone;         // OcctGridPresentation::Zone
+        QVector<float> property;      // Free slot for a cell value, 0 initially
+
+        // Face areas
+        QVector<float> innerArea;     // Cylindrical face at r_i: 2 pi r_i h
+        QVector<float> outerArea;     // Cylindrical face at r_o: 2 pi r_o h
+        QVector<float> horizontalArea; // Top and bottom annulus: pi (r_o^2 - r_i^2)
+
+        // Centroid of the annular cell
+        QVector<float> centroidRadius; // 2/3 (r_o^3 - r_i^3) / (r_o^2 - r_i^2)
+        QVector<float> centroidZ;
+
+        // Centroid distances to the neighbours, 0 where there is none
+        QVector<float> outerDistance;  // To the cell at the same z in ring i + 1
+        QVector<float> lowerDistance;  // To the cell below in the same ring
+
+        // First row and number of rows of each zone
+        int zoneBegin[OcctGridPresentation::ZoneCount] = {};
+        int zoneSize[OcctGridPresentation::ZoneCount] = {};
+
+        int size() const { return zone.size(); }
+    };
+
+    /**
+     * @brief Cell adjacency in compressed sparse row form
+     *
+     * Nodes are the rows of the CellTable followed by the three well
+     * cylinders (wellNode()). The edges of node n are
+     * columns[rowOffsets[n] .. rowOffsets[n + 1]), each with the shared face
+     * area and the distance between the connected centroids (for a cell
+     * against a well cylinder: from the cell centroid to the well wall).
+     * Every connection is stored in both directions.
+     *
+     * The chamber cylinder touches the cells only along an edge, so it is
+     * connected to the aggregate-zone well cylinder alone.
+     */
+    struct CellGraph
+    {
+        enum WellNode {
+            ChamberWell,      // 0 to -chamberDepth
+            AggregateWell,    // Beside the aggregate zone
+            BelowWell,        // Beside the below-well zone
+            WellNodeCount
+        };
+
+        enum EdgeType {
+            RadialEdge,       // Cylindrical face between rings i and i + 1
+            VerticalEdge,     // Horizontal face within a zone
+            ZoneBoundaryEdge, // Aggregate zone bottom / below-well zone top
+            WellEdge          // Against a well cylinder, or between two of them
+        };
+
+        QVector<int> rowOffsets;  // nodeCount() + 1 entries
+        QVector<int> columns;     // Neighbour node per edge
+        QVector<float> area;      // Shared face area per edge
+        QVector<float> distance;  // Centroid distance per edge
+        QVector<quint8> type;     // EdgeType per edge
+        int cellCount = 0;
+
+        int nodeCount() const { return qMax(0, rowOffsets.size() - 1); }
+        int edgeCount() const { return columns.size(); }
+        int wellNode(WellNode well) const { return cellCount + well; }
+    };
+
     /**
      * @brief Constructor with system parameters
      * @param wellRadius Radius of the well (R_w)
@@ -88,12 +181,107 @@ public:
      */
     void generateAll();
 
+    /**
+     * @brief Sets the number of worker threads used for grid generation
+     *
+     * Tube objects and their shapes are built on a worker pool and stored in
+     * deterministic (i, j) order, so the result does not depend on the thread
+     * count. 1 builds everything on the calling thread.
+     *
+     * @param threadCount Number of threads, or 0 to use QThread::idealThreadCount()
+     */
+    void setThreadCount(int threadCount);
+
+    /**
+     * @brief Gets the configured number of worker threads
+     * @return Thread count as set by setThreadCount() (0 means all cores)
+     */
+    int getThreadCount() const;
+
     /**
      * @brief Displays all tubes in the given AIS context
      * @param context The AIS interactive context
      */
     void displayInContext(const Handle(AIS_InteractiveContext)& context);
 
+    /**
+     * @brief Displays the grid as a single batched presentation
+     *
+     * All cells are drawn by one OcctGridPresentation instead of one AIS_Shape
+     * per tube; the well cylinders are displayed as individual objects. The
+     * cells are tessellated analytically from the system parameters, so no
+     * tube BRep is built: generateAggregateZone() / generateBelowWellZone()
+     * are only needed for STEP export and per-object editing. Picked triangles map back to cells through
+     * OcctGridPresentation::detectedCell().
+     *
+     * @param context The AIS interactive context
+     */
+    void displayGridInContext(const Handle(AIS_InteractiveContext)& context);
+
+    /**
+     * @brief Gets the batched grid presentation, creating it on first use
+     * @return Presentation holding every cell of both zones
+     */
+    Handle(OcctGridPresentation) getGridPresentation();
+
+    /**
+     * @brief Colours the cells of one zone by a scalar field
+     *
+     * Maps one value per cell through the colour map and rewrites only the
+     * colour buffer of the batched grid presentation (see
+     * OcctGridPresentation::setCellField()); no geometry, AIS attributes or
+     * tube objects are touched, so this is cheap enough for every time step
+     * of a coupled flow model.
+     *
+     * @param zone AggregateZone or BelowWellZone
+     * @param values Contiguous values indexed by getTubeIndex() (aggregate zone)
+     *               or getBelowWellTubeIndex() (below-well zone)
+     * @param count Number of values, nr * nz_w or nr * nz_g
+     * @param colorMap Maps values to colours
+     * @param context If set, the viewer is redrawn with the new colours
+     * @return false if count does not match the zone
+     */
+    bool setCellField(OcctGridPresentation::Zone zone,
+                      const float* values,
+                      int count,
+                      const OcctColorMap& colorMap,
+                      const Handle(AIS_InteractiveContext)& context = Handle(AIS_InteractiveContext)());
+
+    /**
+     * @brief Colours the cells of one zone with precomputed colours
+     *
+     * Same as setCellField() for colours already mapped through a colour map,
+     * e.g. prepared on a worker thread by OcctFieldAnimator.
+     *
+     * @param zone AggregateZone or BelowWellZone
+     * @param colors One colour per cell, indexed like setCellField() values
+     * @param context If set, the viewer is redrawn with the new colours
+     * @return false if the number of colours does not match the zone
+     */
+    bool setCellColors(OcctGridPresentation::Zone zone,
+                       const QVector<Graphic3d_Vec4ub>& colors,
+                       const Handle(AIS_InteractiveContext)& context = Handle(AIS_InteractiveContext)());
+
+    /**
+     * @brief Renders the grid and well cylinders opaque, for the cutaway view
+     *
+     * With a clipping plane slicing the grid, transparency is no longer needed
+     * to see inside, and blended transparency over many overlapping shells is
+     * the most expensive render mode. The cylinders' opacities are saved and
+     * restored by setOpaque(false). Tubes displayed individually are handled
+     * by their OcctGeo3DObjectSet::setOpaque(); do not call both on a set
+     * filled by addToObjectSet(), as each would restore the other's forced
+     * opacity for the shared well cylinders.
+     *
+     * @param opaque true to force full opacity, false to restore
+     * @param context Context the grid is displayed in; required for the
+     *                change to reach a grid that is already on screen. The
+     *                viewer is not updated.
+     */
+    void setOpaque(bool opaque,
+                   const Handle(AIS_InteractiveContext)& context = Handle(AIS_InteractiveContext)());
+    bool isOpaque() const;
+
     /**
      * @brief Erases all tubes from the given AIS context
      * @param context The AIS interactive context
@@ -103,11 +291,12 @@ public:
     /**
      * @brief Creates an OcctGeo3DObjectSet containing all tubes
      *
-     * Creates a new OcctGeo3DObjectSet and adds all generated tubes to it.
-     * Tubes are named as "tube_r{i}_z{j}" where i is radial index and j is vertical index.
+     * Creates a new OcctGeo3DObjectSet and adds all generated tubes to it
+     * (see addToObjectSet()).
      *
      * @return Pointer to newly created OcctGeo3DObjectSet with all tubes added
-     * @note Caller is responsible for deleting the returned object set
+     * @note Caller is responsible for deleting the returned object set; the
+     *       tubes and cylinders in it stay owned by this system
      * @note Tubes must be generated first using generateAggregateZone()
      */
     OcctGeo3DObjectSet* createObjectSet() const;
@@ -115,8 +304,15 @@ public:
     /**
      * @brief Adds all tubes to an existing OcctGeo3DObjectSet
      *
-     * Adds all generated tubes to the provided object set.
-     * Tubes are named as "tube_r{i}_z{j}" where i is radial index and j is vertical index.
+     * Adds all generated tubes to the provided object set. Tubes are added by
+     * OcctGeo3DObjectSet::ObjectKey {zone, i, j}, with the zone an
+     * OcctGridPresentation::Zone, i the radial and j the vertical index; their
+     * names are "tube_r{i}_z{j}" and "tube_below_r{i}_z{j}". The well
+     * cylinders are named "well_chamber", "well_aggregate" and "well_below".
+     *
+     * All objects are added with OcctGeo3DObjectSet::ExternalOwnership: the
+     * set never deletes them, whatever its ownsObjects() mode. They are valid
+     * until the next generate*() or clear() of this system.
      *
      * @param objectSet Existing OcctGeo3DObjectSet to add tubes to
      * @note Tubes must be generated first using generateAggregateZone()
@@ -125,6 +321,10 @@ public:
 
     /**
      * @brief Gets all tube objects in the aggregate zone
+     *
+     * The tubes of a zone are allocated as one block and owned by this
+     * system; never delete them individually.
+     *
      * @return Vector of pointers to OcctTubeObject instances
      */
     const QVector<OcctTubeObject*>& getTubes() const;
@@ -159,6 +359,8 @@ public:
 
     /**
      * @brief Clears all created tubes
+     *
+     * A displayed grid is removed from its context; the viewer is not updated.
      */
     void clear();
 
@@ -168,8 +370,26 @@ public:
      */
     QJsonObject toJson() const;
 
+    /**
+     * @brief Exports the system in parametric form
+     *
+     * Every tube is fully determined by the system parameters, so only the
+     * parameters are written, plus a sparse list of per-cell overrides holding
+     * just the properties that differ from a freshly generated cell (e.g. a
+     * recoloured or hidden tube). The size no longer grows with the number of
+     * cells, and fromJson() regenerates the grid instead of parsing every tube.
+     *
+     * @return QJsonObject with "format": "parametric"
+     */
+    QJsonObject toCompactJson() const;
+
     /**
      * @brief Imports the system configuration from JSON
+     *
+     * Accepts both the full format of toJson() and the parametric format of
+     * toCompactJson(); the latter regenerates all tubes and applies the
+     * overrides.
+     *
      * @param json QJsonObject containing system data
      * @return true if successful, false otherwise
      */
@@ -190,6 +410,61 @@ public:
     float getVerticalCellSize() const;
     float getBelowWellVerticalCellSize() const;
 
+    /**
+     * @brief Gets the cell table, computing it on first use
+     *
+     * Derived from the system parameters only; no tubes need to be
+     * generated. Rebuilt after clear() or fromJson(); the property column is
+     * kept if both zones keep their number of cells, and reset to 0 otherwise.
+     */
+    const CellTable& getCellTable() const;
+
+    /**
+     * @brief Fills the property column of the cell table
+     *
+     * The values survive a regeneration (generateAll(), fromJson()) that
+     * leaves the number of cells of each zone unchanged.
+     *
+     * @param values One value per row of getCellTable()
+     * @return false if the number of values does not match
+     */
+    bool setCellProperty(const QVector<float>& values);
+
+    /**
+     * @brief Gets the cell adjacency graph, building it on first use
+     *
+     * Built from the indexing and the cell table in O(cells): one pass counts
+     * the edges per node, a second fills them. Rebuilt after clear() or
+     * fromJson().
+     */
+    const CellGraph& getCellGraph() const;
+
+    /**
+     * @brief Cross-checks the analytic cell volumes against OCCT
+     *
+     * Builds the BRep of min(sampleCount, cell count) cells and compares
+     * BRepGProp volumes with the cell table. The samples are split over the
+     * zones in proportion to their size, with at least one per non-empty zone
+     * when sampleCount allows (the larger zones first otherwise), and spread
+     * evenly within each zone. Cells of zero volume are skipped.
+     *
+     * @param sampleCount Number of cells to check
+     * @return Largest relative volume error, or -1 if no cell was checked
+     */
+    double verifyCellTable(int sampleCount = 16) const;
+
+    /**
+     * @brief Gets the storage index of an aggregate zone cell
+     * @return radialIndex * nz_w + verticalIndex
+     */
+    int getTubeIndex(int radialIndex, int verticalIndex) const;
+
+    /**
+     * @brief Gets the storage index of a below-well zone cell
+     * @return radialIndex * nz_g + verticalIndex
+     */
+    int getBelowWellTubeIndex(int radialIndex, int verticalIndex) const;
+
 private:
     // System parameters
     float m_wellRadius;           // R_w
@@ -200,21 +475,57 @@ private:
     int m_nr;                     // Number of radial cells
     int m_nz_w;                   // Number of vertical cells in aggregate zone
     int m_nz_g;                   // Number of vertical cells below aggregate
+    int m_threadCount;            // Generation worker threads (0 = all cores)
+
+    // Prototype tube shapes, one per (ring, zone); cells are placed by location
+    mutable OcctShapeCache m_shapeCache;
 
-    // Generated tubes
+    // Generated tubes; they point into the zone arenas below
     QVector<OcctTubeObject*> m_tubes;
     QVector<OcctTubeObject*> m_belowWellTubes;
 
+    // All cells of a zone in one contiguous block, released with one delete[]
+    std::unique_ptr<OcctTubeObject[]> m_tubeArena;
+    std::unique_ptr<OcctTubeObject[]> m_belowWellTubeArena;
+
+    // Batched presentation of all cells (created on demand)
+    Handle(OcctGridPresentation) m_grid;
+
+    // SoA cell geometry and adjacency (computed on demand, empty when stale)
+    mutable CellTable m_cellTable;
+    mutable CellGraph m_cellGraph;
+
+    // Cutaway state, see setOpaque()
+    bool m_opaque;
+    QVector<float> m_savedCylinderOpacities;
+
     // Well cylinders
     OcctCylinderObject* m_chamberCylinder;        // 0 to -chamberDepth
     OcctCylinderObject* m_aggregateWellCylinder;  // -chamberDepth to -(chamberDepth+aggregateDepth)
     OcctCylinderObject* m_belowWellCylinder;      // -(chamberDepth+aggregateDepth) to -depthToGroundwater
 
     // Helper methods
-    void createTube(int radialIndex, int verticalIndex);
-    void createBelowWellTube(int radialIndex, int verticalIndex);
-    int getTubeIndex(int radialIndex, int verticalIndex) const;
-    int getBelowWellTubeIndex(int radialIndex, int verticalIndex) const;
+    QColor aggregateCellColor(int radialIndex, int verticalIndex) const;
+    QColor belowWellCellColor(int radialIndex, int verticalIndex) const;
+
+    // Sets dimensions, placement and material of a cell as generateAll() creates it
+    typedef void (OcctDrywellSystem::*CellSetup)(OcctTubeObject&, int, int) const;
+    void setupTube(OcctTubeObject& tube, int radialIndex, int verticalIndex) const;
+    void setupBelowWellTube(OcctTubeObject& tube, int radialIndex, int verticalIndex) const;
+
+    void fillCellTable(CellTable& table) const;
+    void fillCellGraph(CellGraph& graph) const;
+
+    static OcctTubeObject* allocateZone(QVector<OcctTubeObject*>& tubes,
+                                        std::unique_ptr<OcctTubeObject[]>& arena, int cellCount);
+    static void releaseZone(QVector<OcctTubeObject*>& tubes, std::unique_ptr<OcctTubeObject[]>& arena);
+    void generateZone(QVector<OcctTubeObject*>& tubes, std::unique_ptr<OcctTubeObject[]>& arena,
+                      int nz, CellSetup setupCell);
+    static void redrawGrid(const Handle(AIS_InteractiveContext)& context);
+    void collectOverrides(QJsonArray& overrides, const QString& zoneName,
+                          const QVector<OcctTubeObject*>& tubes, int nz,
+                          CellSetup setupCell) const;
+    bool applyOverride(const QJsonObject& entry);
 };
 
 #endif // OCCTDRYWELLSYSTEM_H
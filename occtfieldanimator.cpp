@@ -0,0 +1,309 @@
+/**
+ * @file occtfieldanimator.cpp
+ * @brief Implementation of the OcctFieldAnimator class
+ */
+
+#include "occtfieldanimator.h"
+#include "occtdrywellsystem.h"
+
+#include <QDebug>
+#include <QtConcurrent>
+
+namespace {
+
+// Weight of the newest sample in the running averages
+const double kSmoothing = 0.1;
+
+double smooth(double average, double sample)
+{
+    return (average <= 0.0) ? sample : average + kSmoothing * (sample - average);
+}
+
+} // namespace
+
+OcctFieldAnimator::OcctFieldAnimator(QObject* parent)
+    : QObject(parent)
+    , m_drywellSystem(nullptr)
+    , m_colorMap(OcctColorMap::Moisture)
+    , m_frameCount(0)
+    , m_looping(true)
+    , m_front(0)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &OcctFieldAnimator::onTick);
+    setFrameRate(24.0);
+}
+
+OcctFieldAnimator::~OcctFieldAnimator()
+{
+    // The worker writes into m_buffers, let it finish first
+    m_timer.stop();
+    m_pending.waitForFinished();
+}
+
+void OcctFieldAnimator::setDrywellSystem(OcctDrywellSystem* drywellSystem)
+{
+    pause();
+    m_pending.waitForFinished();
+    m_drywellSystem = drywellSystem;
+}
+
+void OcctFieldAnimator::setContext(const Handle(AIS_InteractiveContext)& context)
+{
+    m_context = context;
+}
+
+void OcctFieldAnimator::setTimeSeries(int frameCount, const FrameProvider& provider)
+{
+    pause();
+    m_pending.waitForFinished();
+
+    m_frameCount = qMax(0, frameCount);
+    m_provider = provider;
+    m_buffers[0].frame = -1;
+    m_buffers[1].frame = -1;
+    m_stats = Statistics();
+    m_stats.frameCount = m_frameCount;
+
+    if (m_frameCount > 0) {
+        seek(0);
+    }
+}
+
+void OcctFieldAnimator::setColorMap(const OcctColorMap& colorMap)
+{
+    // The worker reads its own copy, so this is safe during playback
+    m_colorMap = colorMap;
+}
+
+const OcctColorMap& OcctFieldAnimator::getColorMap() const
+{
+    return m_colorMap;
+}
+
+void OcctFieldAnimator::setFrameRate(double framesPerSecond)
+{
+    framesPerSecond = qBound(1.0, framesPerSecond, 120.0);
+    m_timer.setInterval(qRound(1000.0 / framesPerSecond));
+}
+
+double OcctFieldAnimator::getFrameRate() const
+{
+    return 1000.0 / qMax(1, m_timer.interval());
+}
+
+void OcctFieldAnimator::setLooping(bool looping)
+{
+    m_looping = looping;
+}
+
+bool OcctFieldAnimator::isLooping() const
+{
+    return m_looping;
+}
+
+int OcctFieldAnimator::getFrameCount() const
+{
+    return m_frameCount;
+}
+
+int OcctFieldAnimator::getCurrentFrame() const
+{
+    return m_buffers[m_front].frame;
+}
+
+bool OcctFieldAnimator::isPlaying() const
+{
+    return m_timer.isActive();
+}
+
+OcctFieldAnimator::Statistics OcctFieldAnimator::getStatistics() const
+{
+    return m_stats;
+}
+
+void OcctFieldAnimator::play()
+{
+    if (isPlaying() || m_frameCount <= 0 || !m_drywellSystem) {
+        return;
+    }
+
+    // Make sure the frame after the current one is being prepared
+    if (m_pending.isFinished() && m_buffers[1 - m_front].frame != nextFrame(getCurrentFrame())) {
+        requestFrame(nextFrame(getCurrentFrame()));
+    }
+
+    m_frameClock.invalidate();
+    m_timer.start();
+    emit playingChanged(true);
+}
+
+void OcctFieldAnimator::pause()
+{
+    if (!isPlaying()) {
+        return;
+    }
+
+    m_timer.stop();
+    emit playingChanged(false);
+}
+
+void OcctFieldAnimator::togglePlay()
+{
+    if (isPlaying()) {
+        pause();
+    } else {
+        play();
+    }
+}
+
+void OcctFieldAnimator::stepForward()
+{
+    pause();
+    if (m_frameCount <= 0) {
+        return;
+    }
+
+    // The next frame is normally prefetched already
+    m_pending.waitForFinished();
+    int frame = nextFrame(getCurrentFrame());
+    if (frame < 0) {
+        return;
+    }
+    if (m_buffers[1 - m_front].frame != frame) {
+        requestFrame(frame);
+        m_pending.waitForFinished();
+    }
+
+    presentBackBuffer();
+    requestFrame(nextFrame(frame));
+}
+
+void OcctFieldAnimator::seek(int frame)
+{
+    if (frame < 0 || frame >= m_frameCount) {
+        return;
+    }
+
+    m_pending.waitForFinished();
+    requestFrame(frame);
+    m_pending.waitForFinished();
+    presentBackBuffer();
+
+    requestFrame(nextFrame(frame));
+}
+
+void OcctFieldAnimator::onTick()
+{
+    // Keep the current frame on screen until the worker catches up
+    if (!m_pending.isFinished()) {
+        ++m_stats.stalls;
+        emit statisticsChanged();
+        return;
+    }
+
+    int frame = m_buffers[1 - m_front].frame;
+    if (frame < 0) {
+        // End of a non-looping series
+        pause();
+        return;
+    }
+
+    presentBackBuffer();
+    requestFrame(nextFrame(frame));
+}
+
+void OcctFieldAnimator::prepareFrame(FrameBuffer& buffer, int frame,
+                                     const FrameProvider& provider, const OcctColorMap& colorMap)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    buffer.frame = frame;
+    buffer.valid = provider && provider(frame,
+                                        buffer.values[OcctGridPresentation::AggregateZone],
+                                        buffer.values[OcctGridPresentation::BelowWellZone]);
+
+    if (buffer.valid) {
+        for (int zone = 0; zone < OcctGridPresentation::ZoneCount; ++zone) {
+            const QVector<float>& values = buffer.values[zone];
+            QVector<Graphic3d_Vec4ub>& colors = buffer.colors[zone];
+            colors.resize(values.size());
+            for (int k = 0; k < values.size(); ++k) {
+                colors[k] = colorMap.map(values[k]);
+            }
+        }
+    }
+
+    buffer.prepareTime = timer.nsecsElapsed() / 1.0e6;
+}
+
+void OcctFieldAnimator::requestFrame(int frame)
+{
+    FrameBuffer& back = m_buffers[1 - m_front];
+    back.frame = -1;
+    back.valid = false;
+    if (frame < 0 || !m_drywellSystem) {
+        return;
+    }
+
+    // Size the value vectors here so the provider never has to
+    back.values[OcctGridPresentation::AggregateZone].resize(m_drywellSystem->getNr() * m_drywellSystem->getNzW());
+    back.values[OcctGridPresentation::BelowWellZone].resize(m_drywellSystem->getNr() * m_drywellSystem->getNzG());
+
+    // Worker gets copies of everything it reads besides the back buffer
+    FrameProvider provider = m_provider;
+    OcctColorMap colorMap = m_colorMap;
+    m_pending = QtConcurrent::run([&back, frame, provider, colorMap]() {
+        prepareFrame(back, frame, provider, colorMap);
+    });
+}
+
+void OcctFieldAnimator::presentBackBuffer()
+{
+    m_front = 1 - m_front;
+    const FrameBuffer& front = m_buffers[m_front];
+    if (!m_drywellSystem || front.frame < 0) {
+        return;
+    }
+
+    if (!front.valid) {
+        qWarning() << "OcctFieldAnimator: frame" << front.frame << "could not be prepared";
+    } else {
+        QElapsedTimer timer;
+        timer.start();
+
+        // Redraw once, after the last zone
+        m_drywellSystem->setCellColors(OcctGridPresentation::AggregateZone,
+                                       front.colors[OcctGridPresentation::AggregateZone]);
+        m_drywellSystem->setCellColors(OcctGridPresentation::BelowWellZone,
+                                       front.colors[OcctGridPresentation::BelowWellZone],
+                                       m_context);
+
+        m_stats.applyTime = smooth(m_stats.applyTime, timer.nsecsElapsed() / 1.0e6);
+        m_stats.prepareTime = smooth(m_stats.prepareTime, front.prepareTime);
+    }
+
+    if (m_frameClock.isValid() && isPlaying()) {
+        double interval = m_frameClock.nsecsElapsed() / 1.0e6;
+        if (interval > 0.0) {
+            m_stats.fps = smooth(m_stats.fps, 1000.0 / interval);
+        }
+    }
+    m_frameClock.start();
+
+    m_stats.frame = front.frame;
+    emit frameChanged(front.frame);
+    emit statisticsChanged();
+}
+
+int OcctFieldAnimator::nextFrame(int frame) const
+{
+    if (m_frameCount <= 0) {
+        return -1;
+    }
+    if (frame + 1 < m_frameCount) {
+        return frame + 1;
+    }
+    return m_looping ? 0 : -1;
+}
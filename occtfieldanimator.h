@@ -0,0 +1,169 @@
+/**
+ * @file occtfieldanimator.h
+ * @brief Header file for the OcctFieldAnimator class
+ */
+
+#ifndef OCCTFIELDANIMATOR_H
+#define OCCTFIELDANIMATOR_H
+
+#include <QObject>
+#include <QTimer>
+#include <QFuture>
+#include <QVector>
+#include <QElapsedTimer>
+#include <functional>
+
+#include <AIS_InteractiveContext.hxx>
+
+#include "occtcolormap.h"
+#include "occtgridpresentation.h"
+
+class OcctDrywellSystem;
+
+/**
+ * @class OcctFieldAnimator
+ * @brief Plays a time series of cell values through the drywell grid
+ *
+ * Frames are fetched from a FrameProvider and mapped through the colour map on
+ * a worker thread while the current frame is on screen. Two frame buffers are
+ * kept: the front one holds the colours on screen, the back one is filled by
+ * the worker. On each timer tick the buffers are swapped if the back one is
+ * ready, the colours are written in place into the grid presentation
+ * (OcctDrywellSystem::setCellColors()) and the next frame is requested. If the
+ * worker is not done yet the tick is counted as a stall and the current frame
+ * stays on screen.
+ *
+ * Geometry is never touched, so the cost per frame is the colour upload and
+ * one redraw.
+ */
+class OcctFieldAnimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Fills the values of one frame
+     *
+     * Called on a worker thread, must not touch GUI objects. Values are
+     * indexed like OcctDrywellSystem::getTubeIndex() / getBelowWellTubeIndex();
+     * the vectors are already sized to the number of cells of each zone.
+     *
+     * @return false if the frame could not be produced
+     */
+    using FrameProvider = std::function<bool(int frame,
+                                             QVector<float>& aggregateValues,
+                                             QVector<float>& belowWellValues)>;
+
+    /**
+     * @brief Playback statistics, times in milliseconds
+     */
+    struct Statistics
+    {
+        int frame = -1;            // Frame on screen
+        int frameCount = 0;
+        double fps = 0.0;          // Achieved frame rate
+        double applyTime = 0.0;    // Colour upload and redraw on the GUI thread
+        double prepareTime = 0.0;  // Provider and colour mapping on the worker
+        int stalls = 0;            // Ticks where the next frame was not ready
+    };
+
+    explicit OcctFieldAnimator(QObject* parent = nullptr);
+    ~OcctFieldAnimator();
+
+    /**
+     * @brief Sets the system whose grid presentation is animated (not owned)
+     */
+    void setDrywellSystem(OcctDrywellSystem* drywellSystem);
+
+    /**
+     * @brief Sets the context that is redrawn after each frame
+     */
+    void setContext(const Handle(AIS_InteractiveContext)& context);
+
+    /**
+     * @brief Sets the time series to play and shows its first frame
+     * @param frameCount Number of frames
+     * @param provider Produces the values of a frame
+     */
+    void setTimeSeries(int frameCount, const FrameProvider& provider);
+
+    /**
+     * @brief Sets the colour map used for frames prepared from now on
+     */
+    void setColorMap(const OcctColorMap& colorMap);
+    const OcctColorMap& getColorMap() const;
+
+    /**
+     * @brief Sets the target frame rate
+     * @param framesPerSecond Frames per second (clamped to 1..120)
+     */
+    void setFrameRate(double framesPerSecond);
+    double getFrameRate() const;
+
+    void setLooping(bool looping);
+    bool isLooping() const;
+
+    int getFrameCount() const;
+    int getCurrentFrame() const;
+    bool isPlaying() const;
+
+    Statistics getStatistics() const;
+
+public slots:
+    void play();
+    void pause();
+    void togglePlay();
+
+    /**
+     * @brief Shows the next frame (pauses playback)
+     */
+    void stepForward();
+
+    /**
+     * @brief Shows the given frame
+     */
+    void seek(int frame);
+
+signals:
+    void frameChanged(int frame);
+    void playingChanged(bool playing);
+    void statisticsChanged();
+
+private slots:
+    void onTick();
+
+private:
+    struct FrameBuffer
+    {
+        int frame = -1;
+        bool valid = false;
+        double prepareTime = 0.0;
+        QVector<float> values[OcctGridPresentation::ZoneCount];
+        QVector<Graphic3d_Vec4ub> colors[OcctGridPresentation::ZoneCount];
+    };
+
+    static void prepareFrame(FrameBuffer& buffer, int frame,
+                             const FrameProvider& provider, const OcctColorMap& colorMap);
+
+    void requestFrame(int frame);
+    void presentBackBuffer();
+    int nextFrame(int frame) const;
+
+    OcctDrywellSystem* m_drywellSystem;
+    Handle(AIS_InteractiveContext) m_context;
+    FrameProvider m_provider;
+    OcctColorMap m_colorMap;
+    int m_frameCount;
+    bool m_looping;
+
+    // Double buffer: the worker only writes m_buffers[1 - m_front]
+    FrameBuffer m_buffers[2];
+    int m_front;
+    QFuture<void> m_pending;
+
+    QTimer m_timer;
+    QElapsedTimer m_frameClock;
+    Statistics m_stats;
+};
+
+#endif // OCCTFIELDANIMATOR_H
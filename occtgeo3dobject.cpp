@@ -1,6 +1,8 @@
 #include "occtgeo3dobject.h"
 
 #include <BRepBuilderAPI_Transform.hxx>
+#include <TopLoc_Location.hxx>
+#include <gp.hxx>
 #include <cmath>
 
 #ifndef M_PI
@@ -20,6 +22,9 @@ OcctGeo3DObject::OcctGeo3DObject()
     , m_showEdges(false)
     , m_edgeColor(Qt::black)
     , m_edgeWidth(1.0f)
+    , m_preMeshed(false)
+    , m_deferUpdates(false)
+    , m_dirtyFlags(DirtyNone)
     , m_aisShape(nullptr)
 {
 }
@@ -41,7 +46,7 @@ QVector3D OcctGeo3DObject::getPosition() const
 void OcctGeo3DObject::setPosition(const QVector3D& position)
 {
     m_position = position;
-    updateTransform();
+    markDirty(DirtyTransform);
 }
 
 void OcctGeo3DObject::setPosition(float x, float y, float z)
@@ -57,7 +62,7 @@ QVector3D OcctGeo3DObject::getRotation() const
 void OcctGeo3DObject::setRotation(const QVector3D& rotation)
 {
     m_rotation = rotation;
-    updateTransform();
+    markDirty(DirtyTransform);
 }
 
 void OcctGeo3DObject::setRotation(float x, float y, float z)
@@ -73,14 +78,8 @@ QVector3D OcctGeo3DObject::getScale() const
 void OcctGeo3DObject::setScale(const QVector3D& scale)
 {
     m_scale = scale;
-    // Note: OCCT doesn't support non-uniform scaling on shapes easily
-    // We need to recreate the shape with scaling applied
-    if (!m_aisShape.IsNull()) {
-        // Recreate the shape with new scale
-        m_shape = createShape();
-        applyTransformationToShape();
-        m_aisShape->Set(m_shape);
-    }
+    // Note: only uniform scaling is applied (see computeTransformation())
+    markDirty(DirtyTransform);
 }
 
 void OcctGeo3DObject::setScale(float uniformScale)
@@ -105,7 +104,7 @@ QColor OcctGeo3DObject::getDiffuseColor() const
 void OcctGeo3DObject::setDiffuseColor(const QColor& color)
 {
     m_diffuseColor = color;
-    updateMaterial();
+    markDirty(DirtyMaterial);
 }
 
 QColor OcctGeo3DObject::getAmbientColor() const
@@ -116,7 +115,7 @@ QColor OcctGeo3DObject::getAmbientColor() const
 void OcctGeo3DObject::setAmbientColor(const QColor& color)
 {
     m_ambientColor = color;
-    updateMaterial();
+    markDirty(DirtyMaterial);
 }
 
 QColor OcctGeo3DObject::getSpecularColor() const
@@ -127,7 +126,7 @@ QColor OcctGeo3DObject::getSpecularColor() const
 void OcctGeo3DObject::setSpecularColor(const QColor& color)
 {
     m_specularColor = color;
-    updateMaterial();
+    markDirty(DirtyMaterial);
 }
 
 float OcctGeo3DObject::getShininess() const
@@ -138,7 +137,7 @@ float OcctGeo3DObject::getShininess() const
 void OcctGeo3DObject::setShininess(float shininess)
 {
     m_shininess = shininess;
-    updateMaterial();
+    markDirty(DirtyMaterial);
 }
 
 float OcctGeo3DObject::getOpacity() const
@@ -149,7 +148,7 @@ float OcctGeo3DObject::getOpacity() const
 void OcctGeo3DObject::setOpacity(float opacity)
 {
     m_opacity = qBound(0.0f, opacity, 1.0f);
-    updateMaterial();
+    markDirty(DirtyMaterial);
 }
 
 // ============================================
@@ -165,7 +164,10 @@ void OcctGeo3DObject::setVisible(bool visible)
 {
     m_visible = visible;
     // Note: Actual visibility change requires context
-    // Call updateVisibility() if context is available
+    // Call updateVisibility() if context is available, or flushUpdates() when deferred
+    if (m_deferUpdates) {
+        m_dirtyFlags |= DirtyVisibility;
+    }
 }
 
 // ============================================
@@ -180,7 +182,7 @@ bool OcctGeo3DObject::isShowEdges() const
 void OcctGeo3DObject::setShowEdges(bool show)
 {
     m_showEdges = show;
-    updateEdgeDisplay();
+    markDirty(DirtyEdges);
 }
 
 QColor OcctGeo3DObject::getEdgeColor() const
@@ -191,7 +193,7 @@ QColor OcctGeo3DObject::getEdgeColor() const
 void OcctGeo3DObject::setEdgeColor(const QColor& color)
 {
     m_edgeColor = color;
-    updateEdgeDisplay();
+    markDirty(DirtyEdges);
 }
 
 float OcctGeo3DObject::getEdgeWidth() const
@@ -202,7 +204,7 @@ float OcctGeo3DObject::getEdgeWidth() const
 void OcctGeo3DObject::setEdgeWidth(float width)
 {
     m_edgeWidth = width;
-    updateEdgeDisplay();
+    markDirty(DirtyEdges);
 }
 
 // ============================================
@@ -212,27 +214,57 @@ void OcctGeo3DObject::setEdgeWidth(float width)
 Handle(AIS_Shape) OcctGeo3DObject::createAISObject()
 {
     if (m_aisShape.IsNull()) {
-        // Create the shape
-        m_shape = createShape();
+        // Create the shape unless it was already built
+        buildShape();
 
         if (!m_shape.IsNull()) {
-            // Apply transformations to the shape
-            applyTransformationToShape();
-
-            // Create AIS shape
+            // Create AIS shape, placed by its local transformation
             m_aisShape = new AIS_Shape(m_shape);
+            m_aisShape->SetLocalTransformation(computeTransformation());
+
+            // Keep an existing triangulation instead of re-meshing on display
+            m_aisShape->Attributes()->SetAutoTriangulation(m_preMeshed ? Standard_False : Standard_True);
 
             // Apply material properties
             updateMaterial();
 
             // Apply edge display
             updateEdgeDisplay();
+
+            // A fresh AIS object already reflects every pending change
+            m_dirtyFlags = DirtyNone;
         }
     }
 
     return m_aisShape;
 }
 
+void OcctGeo3DObject::buildShape()
+{
+    if (m_shape.IsNull()) {
+        m_shape = createShape();
+    }
+}
+
+void OcctGeo3DObject::rebuildShape()
+{
+    if (m_shape.IsNull()) {
+        return;
+    }
+
+    m_shape = createShape();
+
+    // The new geometry has not been meshed yet
+    setPreMeshed(false);
+
+    if (!m_aisShape.IsNull()) {
+        m_aisShape->Set(m_shape);
+        if (m_aisShape->HasInteractiveContext()) {
+            m_aisShape->InteractiveContext()->Redisplay(m_aisShape, Standard_False);
+        }
+    }
+}
+
 Handle(AIS_Shape) OcctGeo3DObject::getAISShape() const
 {
     return m_aisShape;
@@ -274,18 +306,86 @@ void OcctGeo3DObject::redisplay(const Handle(AIS_InteractiveContext)& context)
     context->Redisplay(m_aisShape, Standard_False);
 }
 
+// ============================================
+// Deferred Updates
+// ============================================
+
+void OcctGeo3DObject::setDeferredUpdates(bool deferred)
+{
+    m_deferUpdates = deferred;
+}
+
+bool OcctGeo3DObject::isDeferredUpdates() const
+{
+    return m_deferUpdates;
+}
+
+int OcctGeo3DObject::getDirtyFlags() const
+{
+    return m_dirtyFlags;
+}
+
+void OcctGeo3DObject::flushUpdates(const Handle(AIS_InteractiveContext)& context)
+{
+    int flags = m_dirtyFlags;
+    m_dirtyFlags = DirtyNone;
+
+    // Without an AIS object createAISObject() applies everything anyway
+    if (flags == DirtyNone || m_aisShape.IsNull()) {
+        return;
+    }
+
+    applyUpdates(flags, context);
+
+    // Material and edge aspects need one recompute of the presentation
+    if (!context.IsNull() && (flags & (DirtyMaterial | DirtyEdges)) && context->IsDisplayed(m_aisShape)) {
+        context->Redisplay(m_aisShape, Standard_False);
+    }
+}
+
+void OcctGeo3DObject::markDirty(int flags)
+{
+    if (m_deferUpdates) {
+        m_dirtyFlags |= flags;
+        return;
+    }
+
+    applyUpdates(flags, nullptr);
+}
+
+void OcctGeo3DObject::applyUpdates(int flags, const Handle(AIS_InteractiveContext)& context)
+{
+    if (flags & DirtyTransform) {
+        updateTransform();
+    }
+    if (flags & DirtyMaterial) {
+        updateMaterial();
+    }
+    if (flags & DirtyEdges) {
+        updateEdgeDisplay();
+    }
+    if (flags & DirtyVisibility) {
+        updateVisibility(context);
+    }
+}
+
 // ============================================
 // Update Methods
 // ============================================
 
 void OcctGeo3DObject::updateTransform()
 {
-    if (!m_aisShape.IsNull()) {
-        // For OCCT, we apply transformation to the shape itself
-        // Recreate shape with new transformation
-        m_shape = createShape();
-        applyTransformationToShape();
-        m_aisShape->Set(m_shape);
+    if (m_aisShape.IsNull()) {
+        return;
+    }
+
+    // Only the location changes, the geometry is left untouched
+    gp_Trsf transform = computeTransformation();
+    if (m_aisShape->HasInteractiveContext()) {
+        // Lets the context keep the selection in sync
+        m_aisShape->InteractiveContext()->SetLocation(m_aisShape, TopLoc_Location(transform));
+    } else {
+        m_aisShape->SetLocalTransformation(transform);
     }
 }
 
@@ -422,25 +522,39 @@ gp_Trsf OcctGeo3DObject::computeTransformation() const
     return transform;
 }
 
-void OcctGeo3DObject::applyTransformationToShape()
+void OcctGeo3DObject::setPreMeshed(bool preMeshed)
 {
-    if (!m_shape.IsNull()) {
-        gp_Trsf transform = computeTransformation();
+    m_preMeshed = preMeshed;
 
-        // Only apply if transformation is not identity
-        bool isIdentity = (transform.Form() == gp_Identity);
-        if (!isIdentity) {
-            BRepBuilderAPI_Transform transformer(m_shape, transform, Standard_True);
-            m_shape = transformer.Shape();
-        }
+    if (!m_aisShape.IsNull()) {
+        m_aisShape->Attributes()->SetAutoTriangulation(m_preMeshed ? Standard_False : Standard_True);
     }
 }
 
+bool OcctGeo3DObject::isPreMeshed() const
+{
+    return m_preMeshed;
+}
+
 TopoDS_Shape OcctGeo3DObject::getShape() const
 {
     return m_shape;
 }
 
+// ============================================
+// Binary Serialization
+// ============================================
+
+int OcctGeo3DObject::writeDimensions(float* /*dimensions*/) const
+{
+    return 0;
+}
+
+bool OcctGeo3DObject::readDimensions(const float* /*dimensions*/, int /*count*/)
+{
+    return true;
+}
+
 // ============================================
 // Factory Registration (Static)
 // ============================================
@@ -452,20 +566,24 @@ void OcctGeo3DObject::registerObjectType(const QString& typeName, ObjectFactory
     s_occtObjectFactories[typeName] = factory;
 }
 
-OcctGeo3DObject* OcctGeo3DObject::createFromJson(const QJsonObject& json)
+OcctGeo3DObject* OcctGeo3DObject::createObject(const QString& typeName)
 {
-    if (!json.contains("type")) {
-        return nullptr;
+    // Read-only lookup: called from loader worker threads
+    auto it = s_occtObjectFactories.constFind(typeName);
+    if (it == s_occtObjectFactories.constEnd()) {
+        return nullptr; // Unknown object type
     }
 
-    QString objectType = json["type"].toString();
+    return it.value()(); // Call factory function
+}
 
-    auto it = s_occtObjectFactories.find(objectType);
-    if (it == s_occtObjectFactories.end()) {
-        return nullptr; // Unknown object type
+OcctGeo3DObject* OcctGeo3DObject::createFromJson(const QJsonObject& json)
+{
+    if (!json.contains("type")) {
+        return nullptr;
     }
 
-    OcctGeo3DObject* object = it.value()(); // Call factory function
+    OcctGeo3DObject* object = createObject(json["type"].toString());
     if (object && object->fromJson(json)) {
         return object;
     } else {
@@ -476,38 +594,21 @@ OcctGeo3DObject* OcctGeo3DObject::createFromJson(const QJsonObject& json)
 
 TopoDS_Shape OcctGeo3DObject::getTransformedShape() const
 {
-    TopoDS_Shape baseShape = getShape();
-
-    if (baseShape.IsNull()) {
-        return baseShape;
+    if (m_shape.IsNull()) {
+        return m_shape;
     }
 
-    // Create transform for position
-    gp_Trsf transform;
-    transform.SetTranslation(gp_Vec(m_position.x(), m_position.y(), m_position.z()));
-
-    // Apply rotation if not zero
-    if (m_rotation.x() != 0.0f || m_rotation.y() != 0.0f || m_rotation.z() != 0.0f) {
-        // Apply rotations around X, Y, Z axes (in radians)
-        gp_Trsf rotX, rotY, rotZ;
-
-        if (m_rotation.x() != 0.0f) {
-            rotX.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(1, 0, 0)), m_rotation.x());
-        }
-
-        if (m_rotation.y() != 0.0f) {
-            rotY.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 1, 0)), m_rotation.y());
-        }
-
-        if (m_rotation.z() != 0.0f) {
-            rotZ.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1)), m_rotation.z());
-        }
+    gp_Trsf transform = computeTransformation();
+    if (transform.Form() == gp_Identity) {
+        return m_shape;
+    }
 
-        // Combine rotations: Z * Y * X (standard order)
-        gp_Trsf rotTransform = rotZ * rotY * rotX;
-        transform = transform * rotTransform;
+    if (std::abs(transform.ScaleFactor() - 1.0) < gp::Resolution()) {
+        // Rigid motion: share the geometry, only attach a location
+        return m_shape.Moved(TopLoc_Location(transform));
     }
 
-    BRepBuilderAPI_Transform transformer(baseShape, transform, Standard_True);
+    // Scaling cannot be expressed as a location, copy the geometry
+    BRepBuilderAPI_Transform transformer(m_shape, transform, Standard_True);
     return transformer.Shape();
 }
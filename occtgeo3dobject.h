@@ -30,10 +30,25 @@
  * This class provides a base for creating 3D objects with OpenCASCADE.
  * It handles transformations (position, rotation, scale), materials,
  * colors, transparency, and edge display.
+ *
+ * The shape is kept in its local frame; position, rotation and uniform scale
+ * are applied as the local transformation of the AIS object, so moving an
+ * object never touches its geometry.
  */
 class OcctGeo3DObject
 {
 public:
+    /**
+     * @brief AIS updates recorded while updates are deferred
+     */
+    enum DirtyFlag {
+        DirtyNone       = 0x0,
+        DirtyTransform  = 0x1,
+        DirtyMaterial   = 0x2,
+        DirtyEdges      = 0x4,
+        DirtyVisibility = 0x8
+    };
+
     explicit OcctGeo3DObject();
     virtual ~OcctGeo3DObject();
 
@@ -89,11 +104,62 @@ public:
     void eraseFromContext(const Handle(AIS_InteractiveContext)& context);
     void redisplay(const Handle(AIS_InteractiveContext)& context);
 
+    /**
+     * @brief Enables or disables deferred AIS updates
+     *
+     * While deferred, property setters only record DirtyFlag bits instead of
+     * rewriting the AIS attributes; flushUpdates() applies them all at once.
+     * Disabling does not flush pending changes.
+     *
+     * @param deferred true to record changes, false to apply them immediately
+     */
+    void setDeferredUpdates(bool deferred);
+    bool isDeferredUpdates() const;
+
+    /**
+     * @brief Gets the pending updates
+     * @return Combination of DirtyFlag bits
+     */
+    int getDirtyFlags() const;
+
+    /**
+     * @brief Applies all pending updates and redisplays the object once
+     * @param context The AIS interactive context (may be null if not displayed)
+     */
+    void flushUpdates(const Handle(AIS_InteractiveContext)& context);
+
     // JSON Serialization
     virtual QJsonObject toJson() const = 0;
     virtual bool fromJson(const QJsonObject& json) = 0;
     virtual QString getObjectType() const = 0;
 
+    /**
+     * @brief Maximum number of type-specific dimensions in a binary record
+     */
+    enum { MaxBinaryDimensions = 4 };
+
+    /**
+     * @brief Writes the type-specific dimensions for the binary format
+     * @param dimensions Receives up to MaxBinaryDimensions values
+     * @return Number of values written (default: none)
+     */
+    virtual int writeDimensions(float* dimensions) const;
+
+    /**
+     * @brief Restores the type-specific dimensions from the binary format
+     * @param dimensions Values as written by writeDimensions()
+     * @param count Number of values
+     * @return false if the values are not valid for this type
+     */
+    virtual bool readDimensions(const float* dimensions, int count);
+
+    /**
+     * @brief Creates an empty object of a registered type
+     * @param typeName Type name as returned by getObjectType()
+     * @return New object, or nullptr if the type is unknown
+     */
+    static OcctGeo3DObject* createObject(const QString& typeName);
+
     /**
      * @brief Creates an OcctGeo3DObject from JSON data
      *
@@ -116,12 +182,40 @@ public:
      */
     static void registerObjectType(const QString& typeName, ObjectFactory factory);
 
-    // Access to the shape for derived classes
+    /**
+     * @brief Builds the untransformed shape if not built yet
+     *
+     * createAISObject() reuses a shape built here, so the expensive geometry
+     * work can be done up front. Objects are independent, so this may be
+     * called concurrently on different objects from worker threads.
+     */
+    void buildShape();
+
+    /**
+     * @brief Marks the shape as already tessellated
+     *
+     * When set, the AIS object reuses the triangulation stored in the shape
+     * (e.g. by OcctGeo3DObjectSet::meshAll()) and never re-meshes it on
+     * display, redisplay or colour changes.
+     *
+     * @param preMeshed true if the shape carries its triangulation
+     */
+    void setPreMeshed(bool preMeshed);
+    bool isPreMeshed() const;
+
+    /**
+     * @brief Gets the shape in its local frame (no position/rotation/scale)
+     * @return Untransformed TopoDS_Shape, null if not built yet
+     */
     TopoDS_Shape getShape() const;
 
     /**
-     * @brief Gets the shape with position/rotation transforms applied
-     * @return Transformed TopoDS_Shape
+     * @brief Gets the shape with position/rotation/scale transforms applied
+     *
+     * Rigid transforms are attached as a TopLoc_Location sharing the geometry;
+     * only a uniform scale different from 1 copies the shape.
+     *
+     * @return Transformed TopoDS_Shape, null if the shape was not built yet
      */
     TopoDS_Shape getTransformedShape() const;
 
@@ -129,6 +223,14 @@ protected:
     // Pure virtual method for creating shape - must be implemented by derived classes
     virtual TopoDS_Shape createShape() = 0;
 
+    /**
+     * @brief Rebuilds the geometry after a dimension change
+     *
+     * Transform changes never need this; they only update the location of the
+     * AIS object. Does nothing if the shape was never built.
+     */
+    void rebuildShape();
+
     // Update methods - called when properties change
     virtual void updateTransform();
     virtual void updateMaterial();
@@ -161,13 +263,21 @@ private:
     QColor m_edgeColor;
     float m_edgeWidth;
 
+    // Tessellation is provided externally
+    bool m_preMeshed;
+
+    // Deferred update state
+    bool m_deferUpdates;
+    int m_dirtyFlags;
+
     // OpenCASCADE objects
     Handle(AIS_Shape) m_aisShape;
     TopoDS_Shape m_shape;
 
     // Helper methods
     gp_Trsf computeTransformation() const;
-    void applyTransformationToShape();
+    void markDirty(int flags);
+    void applyUpdates(int flags, const Handle(AIS_InteractiveContext)& context);
 
 };
 
@@ -2,8 +2,16 @@
 #include "occtgeo3dobject.h"
 
 #include <QJsonDocument>
+#include <QJsonArray>
 #include <QFile>
 #include <QIODevice>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <TopLoc_Location.hxx>
 #include <STEPControl_Writer.hxx>
 #include <STEPControl_StepModelType.hxx>
 #include <TopoDS_Compound.hxx>
@@ -13,8 +21,290 @@
 #include <TCollection_AsciiString.hxx>
 #include <Standard_Failure.hxx>
 
+#include <cstring>
+
+namespace {
+
+// ============================================
+// Binary format (version 1)
+// ============================================
+//
+// [FileHeader][type table: typeCount x TypeEntry][records: objectCount x ObjectRecord][names]
+// All sections start at offsets that are multiples of 8.
+
+const char kBinaryMagic[8] = { 'D', 'W', 'O', 'B', 'J', 'S', 'E', 'T' };
+const quint32 kBinaryVersion = 1;
+const quint32 kByteOrderMark = 0x01020304;
+
+struct FileHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 byteOrderMark;
+    quint32 typeCount;
+    quint32 objectCount;
+    quint64 typeTableOffset;
+    quint64 recordsOffset;
+    quint64 namesOffset;
+    quint64 namesSize;
+};
+
+struct TypeEntry
+{
+    char name[32];  // Null-padded type name
+};
+
+enum RecordFlags {
+    RecordVisible   = 0x1,
+    RecordShowEdges = 0x2
+};
+
+struct ObjectRecord
+{
+    quint32 typeIndex;
+    quint32 flags;
+    quint32 nameOffset;  // Into the names section
+    quint32 nameLength;  // In bytes
+    float position[3];
+    float rotation[3];
+    float scale[3];
+    quint32 diffuse;     // RGBA, see packColor()
+    quint32 ambient;
+    quint32 specular;
+    quint32 edgeColor;
+    float shininess;
+    float opacity;
+    float edgeWidth;
+    quint32 dimensionCount;
+    float dimensions[OcctGeo3DObject::MaxBinaryDimensions];
+};
+
+static_assert(sizeof(FileHeader) == 56, "FileHeader layout changed");
+static_assert(sizeof(ObjectRecord) == 100, "ObjectRecord layout changed");
+
+quint32 packColor(const QColor& color)
+{
+    return (quint32(color.red()) << 24) | (quint32(color.green()) << 16)
+           | (quint32(color.blue()) << 8) | quint32(color.alpha());
+}
+
+QColor unpackColor(quint32 rgba)
+{
+    return QColor((rgba >> 24) & 0xff, (rgba >> 16) & 0xff, (rgba >> 8) & 0xff, rgba & 0xff);
+}
+
+quint64 alignTo8(quint64 offset)
+{
+    return (offset + 7) & ~quint64(7);
+}
+
+// Checks that count elements at an untrusted offset lie inside the file,
+// behind the header and 8-byte aligned; written so nothing can wrap
+bool isValidSection(quint64 offset, quint64 count, quint64 elementSize, quint64 fileSize)
+{
+    return offset >= sizeof(FileHeader)
+           && offset % 8 == 0
+           && offset <= fileSize
+           && count <= (fileSize - offset) / elementSize;
+}
+
+// ============================================
+// Streaming JSON
+// ============================================
+
+const qint64 kJsonChunkSize = 64 * 1024;
+
+// Encodes a string as a JSON string literal
+QByteArray jsonString(const QString& text)
+{
+    QByteArray array = QJsonDocument(QJsonArray{ text }).toJson(QJsonDocument::Compact);
+    return array.mid(1, array.size() - 2);
+}
+
+/**
+ * @brief Pull scanner over the JSON text of a device
+ *
+ * Only tokenises as far as needed to split the document into members; the
+ * text of each member value is handed to QJsonDocument. Consumed input is
+ * dropped when the buffer is refilled, so memory is bounded by the largest
+ * single value.
+ */
+class JsonScanner
+{
+public:
+    explicit JsonScanner(QIODevice* device)
+        : m_device(device)
+        , m_pos(0)
+    {
+    }
+
+    // Next non-whitespace character without consuming it, or -1 at the end
+    int peek()
+    {
+        while (true) {
+            if (m_pos >= m_buffer.size() && !refill()) {
+                return -1;
+            }
+            char c = m_buffer[m_pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                return c;
+            }
+            ++m_pos;
+        }
+    }
+
+    bool expect(char c)
+    {
+        if (peek() != c) {
+            return false;
+        }
+        ++m_pos;
+        return true;
+    }
+
+    // Raw text of the next value (object, array, string or scalar)
+    bool readValue(QByteArray& raw)
+    {
+        raw.clear();
+        int c = peek();
+        if (c < 0) {
+            return false;
+        }
+
+        int depth = 0;
+        bool inString = false;
+        bool escaped = false;
+        while (true) {
+            if (m_pos >= m_buffer.size() && !refill()) {
+                // A scalar may end the input; anything else is truncated
+                return depth == 0 && !inString && !raw.isEmpty();
+            }
+            char ch = m_buffer[m_pos];
+
+            if (inString) {
+                raw.append(ch);
+                ++m_pos;
+                if (escaped) {
+                    escaped = false;
+                } else if (ch == '\\') {
+                    escaped = true;
+                } else if (ch == '"') {
+                    inString = false;
+                    if (depth == 0) {
+                        return true;
+                    }
+                }
+                continue;
+            }
+
+            if (depth == 0 && !raw.isEmpty()
+                && (ch == ',' || ch == '}' || ch == ']' || ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r')) {
+                // End of a scalar
+                return true;
+            }
+
+            raw.append(ch);
+            ++m_pos;
+            if (ch == '"') {
+                inString = true;
+            } else if (ch == '{' || ch == '[') {
+                ++depth;
+            } else if (ch == '}' || ch == ']') {
+                if (--depth == 0) {
+                    return true;
+                }
+                if (depth < 0) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Decoded member name
+    bool readKey(QString& key)
+    {
+        QByteArray raw;
+        if (peek() != '"' || !readValue(raw) || !expect(':')) {
+            return false;
+        }
+        QJsonDocument doc = QJsonDocument::fromJson("[" + raw + "]");
+        key = doc.array().at(0).toString();
+        return true;
+    }
+
+private:
+    bool refill()
+    {
+        m_buffer.remove(0, m_pos);
+        m_pos = 0;
+        QByteArray chunk = m_device->read(kJsonChunkSize);
+        if (chunk.isEmpty()) {
+            return false;
+        }
+        m_buffer.append(chunk);
+        return true;
+    }
+
+    QIODevice* m_device;
+    QByteArray m_buffer;
+    qsizetype m_pos;
+};
+
+// ============================================
+// Parallel object creation
+// ============================================
+
+// Objects handed to the JSON reader per parallel batch
+const int kJsonBatchSize = 4096;
+
+/**
+ * @brief One "objects" entry on its way from JSON to the set
+ *
+ * Either data or text (unparsed JSON) is set on input; object is the result.
+ */
+struct PendingObject
+{
+    QString name;
+    QByteArray text;
+    QJsonObject data;
+    OcctGeo3DObject* object = nullptr;
+};
+
+// Runs factory lookup and fromJson() of every entry on a pool. The new
+// objects are not shared with anything yet, so each worker only touches its
+// own entry.
+void createObjects(QVector<PendingObject>& pending, int threadCount)
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount((threadCount > 0) ? threadCount : QThread::idealThreadCount());
+
+    QtConcurrent::blockingMap(&pool, pending, [](PendingObject& entry) {
+        if (!entry.text.isEmpty()) {
+            QJsonDocument doc = QJsonDocument::fromJson(entry.text);
+            entry.text.clear();
+            if (!doc.isObject()) {
+                return;
+            }
+            entry.data = doc.object();
+        }
+        entry.object = OcctGeo3DObject::createFromJson(entry.data);
+        entry.data = QJsonObject();
+    });
+}
+
+} // namespace
+
 OcctGeo3DObjectSet::OcctGeo3DObjectSet()
-    : m_ownsObjects(true)
+    : m_nameIndexBuilt(false)
+    , m_keyIndexBuilt(false)
+    , m_ownsObjects(true)
+    , m_deferredUpdates(false)
+    , m_opaque(false)
+    , m_threadCount(0)
+    , m_linearDeflection(0.01)
+    , m_angularDeflection(0.5)
+    , m_lastMeshTime(0)
+    , m_lastDisplayTime(0)
 {
 }
 
@@ -23,57 +313,246 @@ OcctGeo3DObjectSet::~OcctGeo3DObjectSet()
     clear();
 }
 
-void OcctGeo3DObjectSet::addObject(const QString& name, OcctGeo3DObject* object)
+OcctGeo3DObjectSet::ObjectHandle OcctGeo3DObjectSet::addObject(OcctGeo3DObject* object, const ObjectKey& key,
+                                                               Ownership ownership)
 {
     if (!object) {
-        return;
+        return InvalidHandle;
+    }
+
+    ObjectHandle handle;
+    if (!m_freeHandles.isEmpty()) {
+        handle = m_freeHandles.takeLast();
+        m_slots[handle] = m_objects.size();
+    } else {
+        handle = m_slots.size();
+        m_slots.append(m_objects.size());
+    }
+
+    object->setDeferredUpdates(m_deferredUpdates);
+    m_objects.append(object);
+    m_keys.append(key);
+    m_names.append(QString());
+    m_handles.append(handle);
+    m_ownership.append(ownership);
+
+    if (m_keyIndexBuilt && key.isValid()) {
+        m_keyIndex.insert(key, handle);
+    }
+
+    // The name is derived from the key; rebuild the index when it is needed
+    if (m_nameIndexBuilt && key.isValid()) {
+        m_nameIndexBuilt = false;
+        m_nameIndex.clear();
+    }
+
+    return handle;
+}
+
+OcctGeo3DObjectSet::ObjectHandle OcctGeo3DObjectSet::addObject(const QString& name, OcctGeo3DObject* object,
+                                                               Ownership ownership)
+{
+    if (!object) {
+        return InvalidHandle;
     }
 
     // If an object with this name already exists, remove it first
-    if (m_objects.contains(name)) {
-        removeObject(name);
+    removeObject(name);
+
+    ObjectHandle handle = addObject(object, ObjectKey(), ownership);
+    m_names.last() = name;
+    if (m_nameIndexBuilt) {
+        m_nameIndex.insert(name, handle);
+    }
+    return handle;
+}
+
+bool OcctGeo3DObjectSet::removeObject(ObjectHandle handle)
+{
+    int index = indexOf(handle);
+    if (index < 0) {
+        return false;
+    }
+
+    if (m_ownsObjects && m_ownership[index] == SetOwnership) {
+        delete m_objects[index];
     }
 
-    m_objects.insert(name, object);
+    if (m_nameIndexBuilt) {
+        m_nameIndex.remove(nameAt(index));
+    }
+    if (m_keyIndexBuilt && m_keys[index].isValid()) {
+        m_keyIndex.remove(m_keys[index]);
+    }
+    m_savedOpacities.remove(handle);
+
+    // Swap-remove; the moved object keeps its handle
+    int last = m_objects.size() - 1;
+    if (index != last) {
+        m_objects[index] = m_objects[last];
+        m_keys[index] = m_keys[last];
+        m_names[index] = m_names[last];
+        m_handles[index] = m_handles[last];
+        m_ownership[index] = m_ownership[last];
+        m_slots[m_handles[index]] = index;
+    }
+    m_objects.removeLast();
+    m_keys.removeLast();
+    m_names.removeLast();
+    m_handles.removeLast();
+    m_ownership.removeLast();
+
+    m_slots[handle] = -1;
+    m_freeHandles.append(handle);
+    return true;
 }
 
 bool OcctGeo3DObjectSet::removeObject(const QString& name)
 {
-    auto it = m_objects.find(name);
-    if (it != m_objects.end()) {
-        if (m_ownsObjects && it.value()) {
-            delete it.value();
-        }
-        m_objects.erase(it);
-        return true;
-    }
-    return false;
+    return removeObject(findObject(name));
 }
 
 void OcctGeo3DObjectSet::clear()
 {
     if (m_ownsObjects) {
-        for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-            delete it.value();
+        for (int index = 0; index < m_objects.size(); ++index) {
+            if (m_ownership[index] == SetOwnership) {
+                delete m_objects[index];
+            }
         }
     }
     m_objects.clear();
+    m_keys.clear();
+    m_names.clear();
+    m_handles.clear();
+    m_ownership.clear();
+    m_slots.clear();
+    m_freeHandles.clear();
+    m_savedOpacities.clear();
+
+    m_nameIndex.clear();
+    m_nameIndexBuilt = false;
+    m_keyIndex.clear();
+    m_keyIndexBuilt = false;
+}
+
+void OcctGeo3DObjectSet::setOwnsObjects(bool owns)
+{
+    m_ownsObjects = owns;
+}
+
+bool OcctGeo3DObjectSet::ownsObjects() const
+{
+    return m_ownsObjects;
+}
+
+void OcctGeo3DObjectSet::reserve(int count)
+{
+    m_objects.reserve(count);
+    m_keys.reserve(count);
+    m_names.reserve(count);
+    m_handles.reserve(count);
+    m_ownership.reserve(count);
+    m_slots.reserve(count);
+}
+
+OcctGeo3DObject* OcctGeo3DObjectSet::getObject(ObjectHandle handle) const
+{
+    int index = indexOf(handle);
+    return (index >= 0) ? m_objects[index] : nullptr;
 }
 
 OcctGeo3DObject* OcctGeo3DObjectSet::getObject(const QString& name) const
 {
-    auto it = m_objects.find(name);
-    return (it != m_objects.end()) ? it.value() : nullptr;
+    return getObject(findObject(name));
+}
+
+OcctGeo3DObject* OcctGeo3DObjectSet::getObject(const ObjectKey& key) const
+{
+    return getObject(findObject(key));
+}
+
+OcctGeo3DObjectSet::ObjectHandle OcctGeo3DObjectSet::findObject(const QString& name) const
+{
+    if (!m_nameIndexBuilt) {
+        m_nameIndex.clear();
+        m_nameIndex.reserve(m_objects.size());
+        for (int index = 0; index < m_objects.size(); ++index) {
+            m_nameIndex.insert(nameAt(index), m_handles[index]);
+        }
+        m_nameIndexBuilt = true;
+    }
+    return m_nameIndex.value(name, InvalidHandle);
+}
+
+OcctGeo3DObjectSet::ObjectHandle OcctGeo3DObjectSet::findObject(const ObjectKey& key) const
+{
+    if (!key.isValid()) {
+        return InvalidHandle;
+    }
+    if (!m_keyIndexBuilt) {
+        m_keyIndex.clear();
+        m_keyIndex.reserve(m_objects.size());
+        for (int index = 0; index < m_objects.size(); ++index) {
+            if (m_keys[index].isValid()) {
+                m_keyIndex.insert(m_keys[index], m_handles[index]);
+            }
+        }
+        m_keyIndexBuilt = true;
+    }
+    return m_keyIndex.value(key, InvalidHandle);
 }
 
 bool OcctGeo3DObjectSet::contains(const QString& name) const
 {
-    return m_objects.contains(name);
+    return findObject(name) != InvalidHandle;
+}
+
+bool OcctGeo3DObjectSet::contains(ObjectHandle handle) const
+{
+    return indexOf(handle) >= 0;
+}
+
+QString OcctGeo3DObjectSet::getName(ObjectHandle handle) const
+{
+    int index = indexOf(handle);
+    return (index >= 0) ? nameAt(index) : QString();
+}
+
+OcctGeo3DObjectSet::ObjectKey OcctGeo3DObjectSet::getKey(ObjectHandle handle) const
+{
+    int index = indexOf(handle);
+    return (index >= 0) ? m_keys[index] : ObjectKey();
+}
+
+OcctGeo3DObjectSet::Ownership OcctGeo3DObjectSet::getOwnership(ObjectHandle handle) const
+{
+    int index = indexOf(handle);
+    return (index >= 0) ? m_ownership[index] : SetOwnership;
+}
+
+void OcctGeo3DObjectSet::setZonePrefix(int zone, const QString& prefix)
+{
+    m_zonePrefixes.insert(zone, prefix);
+
+    // Derived names change
+    m_nameIndex.clear();
+    m_nameIndexBuilt = false;
+}
+
+QString OcctGeo3DObjectSet::getZonePrefix(int zone) const
+{
+    return m_zonePrefixes.value(zone, QString("zone%1_").arg(zone));
 }
 
 QStringList OcctGeo3DObjectSet::getObjectNames() const
 {
-    return m_objects.keys();
+    QStringList names;
+    names.reserve(m_objects.size());
+    for (int index = 0; index < m_objects.size(); ++index) {
+        names.append(nameAt(index));
+    }
+    return names;
 }
 
 int OcctGeo3DObjectSet::count() const
@@ -86,49 +565,71 @@ bool OcctGeo3DObjectSet::isEmpty() const
     return m_objects.isEmpty();
 }
 
-QMap<QString, OcctGeo3DObject*>::iterator OcctGeo3DObjectSet::begin()
+OcctGeo3DObjectSet::ObjectHandle OcctGeo3DObjectSet::handleAt(int index) const
 {
-    return m_objects.begin();
+    return m_handles.value(index, InvalidHandle);
 }
 
-QMap<QString, OcctGeo3DObject*>::iterator OcctGeo3DObjectSet::end()
+OcctGeo3DObject* OcctGeo3DObjectSet::objectAt(int index) const
 {
-    return m_objects.end();
+    return m_objects.value(index, nullptr);
 }
 
-QMap<QString, OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::begin() const
+const QVector<OcctGeo3DObject*>& OcctGeo3DObjectSet::getObjects() const
 {
-    return m_objects.begin();
+    return m_objects;
+}
+
+QVector<OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::begin() const
+{
+    return m_objects.constBegin();
 }
 
-QMap<QString, OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::end() const
+QVector<OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::end() const
 {
-    return m_objects.end();
+    return m_objects.constEnd();
 }
 
-QMap<QString, OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::constBegin() const
+QVector<OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::constBegin() const
 {
     return m_objects.constBegin();
 }
 
-QMap<QString, OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::constEnd() const
+QVector<OcctGeo3DObject*>::const_iterator OcctGeo3DObjectSet::constEnd() const
 {
     return m_objects.constEnd();
 }
 
+int OcctGeo3DObjectSet::indexOf(ObjectHandle handle) const
+{
+    return (handle >= 0 && handle < m_slots.size()) ? m_slots[handle] : -1;
+}
+
+QString OcctGeo3DObjectSet::nameAt(int index) const
+{
+    const ObjectKey& key = m_keys[index];
+    if (!m_names[index].isEmpty() || !key.isValid()) {
+        return m_names[index];
+    }
+    return getZonePrefix(key.zone) + QString("r%1_z%2").arg(key.radial).arg(key.vertical);
+}
+
 void OcctGeo3DObjectSet::displayAll(const Handle(AIS_InteractiveContext)& context)
 {
     if (context.IsNull()) {
         return;
     }
 
-    for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
-        if (it.value()) {
-            it.value()->displayInContext(context);
-        }
+    QElapsedTimer timer;
+    timer.start();
+
+    for (OcctGeo3DObject* object : m_objects) {
+        object->displayInContext(context);
     }
 
     context->UpdateCurrentViewer();
+
+    m_lastDisplayTime = timer.elapsed();
 }
 
 void OcctGeo3DObjectSet::eraseAll(const Handle(AIS_InteractiveContext)& context)
@@ -137,10 +638,8 @@ void OcctGeo3DObjectSet::eraseAll(const Handle(AIS_InteractiveContext)& context)
         return;
     }
 
-    for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
-        if (it.value()) {
-            it.value()->eraseFromContext(context);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->eraseFromContext(context);
     }
 
     context->UpdateCurrentViewer();
@@ -152,10 +651,8 @@ void OcctGeo3DObjectSet::redisplayAll(const Handle(AIS_InteractiveContext)& cont
         return;
     }
 
-    for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
-        if (it.value()) {
-            it.value()->redisplay(context);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->redisplay(context);
     }
 
     context->UpdateCurrentViewer();
@@ -168,13 +665,113 @@ void OcctGeo3DObjectSet::updateViewer(const Handle(AIS_InteractiveContext)& cont
     }
 }
 
-void OcctGeo3DObjectSet::setAllVisible(bool visible)
+void OcctGeo3DObjectSet::setDeferredUpdates(bool deferred)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setVisible(visible);
+    m_deferredUpdates = deferred;
+
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setDeferredUpdates(deferred);
+    }
+}
+
+bool OcctGeo3DObjectSet::isDeferredUpdates() const
+{
+    return m_deferredUpdates;
+}
+
+void OcctGeo3DObjectSet::flush(const Handle(AIS_InteractiveContext)& context)
+{
+    for (OcctGeo3DObject* object : m_objects) {
+        object->flushUpdates(context);
+    }
+
+    if (!context.IsNull()) {
+        context->UpdateCurrentViewer();
+    }
+}
+
+void OcctGeo3DObjectSet::setThreadCount(int threadCount)
+{
+    m_threadCount = qMax(0, threadCount);
+}
+
+int OcctGeo3DObjectSet::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+void OcctGeo3DObjectSet::setMeshDeflection(double linearDeflection, double angularDeflection)
+{
+    m_linearDeflection = linearDeflection;
+    m_angularDeflection = angularDeflection;
+}
+
+double OcctGeo3DObjectSet::getLinearDeflection() const
+{
+    return m_linearDeflection;
+}
+
+double OcctGeo3DObjectSet::getAngularDeflection() const
+{
+    return m_angularDeflection;
+}
+
+qint64 OcctGeo3DObjectSet::meshAll()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QThreadPool pool;
+    pool.setMaxThreadCount((m_threadCount > 0) ? m_threadCount : QThread::idealThreadCount());
+
+    // Build missing shapes; every object only touches itself
+    const QVector<OcctGeo3DObject*> objects = m_objects;
+    QtConcurrent::blockingMap(&pool, objects, [](OcctGeo3DObject* object) {
+        object->buildShape();
+    });
+
+    // Mesh each distinct geometry once: objects sharing a prototype share its
+    // TShape, and meshing the same faces from two threads would race
+    QVector<TopoDS_Shape> uniqueShapes;
+    QSet<const void*> seen;
+    for (OcctGeo3DObject* object : objects) {
+        TopoDS_Shape shape = object->getShape();
+        if (!shape.IsNull() && !seen.contains(shape.TShape().get())) {
+            seen.insert(shape.TShape().get());
+            uniqueShapes.append(shape.Located(TopLoc_Location()));
         }
     }
+
+    double linearDeflection = m_linearDeflection;
+    double angularDeflection = m_angularDeflection;
+    QtConcurrent::blockingMap(&pool, uniqueShapes, [=](const TopoDS_Shape& shape) {
+        BRepMesh_IncrementalMesh mesher(shape, linearDeflection, Standard_False,
+                                        angularDeflection, Standard_False);
+    });
+
+    for (OcctGeo3DObject* object : objects) {
+        object->setPreMeshed(true);
+    }
+
+    m_lastMeshTime = timer.elapsed();
+    return m_lastMeshTime;
+}
+
+qint64 OcctGeo3DObjectSet::getLastMeshTime() const
+{
+    return m_lastMeshTime;
+}
+
+qint64 OcctGeo3DObjectSet::getLastDisplayTime() const
+{
+    return m_lastDisplayTime;
+}
+
+void OcctGeo3DObjectSet::setAllVisible(bool visible)
+{
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setVisible(visible);
+    }
 }
 
 void OcctGeo3DObjectSet::setObjectVisible(const QString& name, bool visible)
@@ -187,70 +784,82 @@ void OcctGeo3DObjectSet::setObjectVisible(const QString& name, bool visible)
 
 void OcctGeo3DObjectSet::setAllDiffuseColor(const QColor& color)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setDiffuseColor(color);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setDiffuseColor(color);
     }
 }
 
 void OcctGeo3DObjectSet::setAllScale(float uniformScale)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setScale(uniformScale);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setScale(uniformScale);
     }
 }
 
 void OcctGeo3DObjectSet::setAllScale(const QVector3D& scale)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setScale(scale);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setScale(scale);
     }
 }
 
 void OcctGeo3DObjectSet::setAllShowEdges(bool show)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setShowEdges(show);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setShowEdges(show);
     }
 }
 
 void OcctGeo3DObjectSet::setAllEdgeColor(const QColor& color)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setEdgeColor(color);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setEdgeColor(color);
     }
 }
 
 void OcctGeo3DObjectSet::setAllEdgeWidth(float width)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setEdgeWidth(width);
-        }
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setEdgeWidth(width);
     }
 }
 
 void OcctGeo3DObjectSet::setAllOpacity(float opacity)
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-        if (it.value()) {
-            it.value()->setOpacity(opacity);
+    for (OcctGeo3DObject* object : m_objects) {
+        object->setOpacity(opacity);
+    }
+}
+
+void OcctGeo3DObjectSet::setOpaque(bool opaque)
+{
+    if (m_opaque == opaque) {
+        return;
+    }
+    m_opaque = opaque;
+
+    if (opaque) {
+        m_savedOpacities.clear();
+        m_savedOpacities.reserve(m_objects.size());
+        for (int index = 0; index < m_objects.size(); ++index) {
+            m_savedOpacities.insert(m_handles[index], m_objects[index]->getOpacity());
+            m_objects[index]->setOpacity(1.0f);
         }
+    } else {
+        // Objects added while opaque keep their own opacity
+        for (auto it = m_savedOpacities.constBegin(); it != m_savedOpacities.constEnd(); ++it) {
+            OcctGeo3DObject* object = getObject(it.key());
+            if (object) {
+                object->setOpacity(it.value());
+            }
+        }
+        m_savedOpacities.clear();
     }
 }
 
-const QMap<QString, OcctGeo3DObject*>& OcctGeo3DObjectSet::getObjectMap() const
+bool OcctGeo3DObjectSet::isOpaque() const
 {
-    return m_objects;
+    return m_opaque;
 }
 
 QJsonObject OcctGeo3DObjectSet::toJson() const
@@ -260,10 +869,8 @@ QJsonObject OcctGeo3DObjectSet::toJson() const
     json["objectCount"] = m_objects.size();
 
     QJsonObject objectsJson;
-    for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
-        if (it.value()) {
-            objectsJson[it.key()] = it.value()->toJson();
-        }
+    for (int index = 0; index < m_objects.size(); ++index) {
+        objectsJson[nameAt(index)] = m_objects[index]->toJson();
     }
 
     json["objects"] = objectsJson;
@@ -285,40 +892,135 @@ bool OcctGeo3DObjectSet::fromJson(const QJsonObject& json)
     }
 
     QJsonObject objectsJson = json["objects"].toObject();
-    for (auto it = objectsJson.begin(); it != objectsJson.end(); ++it) {
-        QString name = it.key();
+    QVector<PendingObject> pending;
+    pending.reserve(objectsJson.size());
+    for (auto it = objectsJson.constBegin(); it != objectsJson.constEnd(); ++it) {
+        if (it.value().isObject()) {
+            PendingObject entry;
+            entry.name = it.key();
+            entry.data = it.value().toObject();
+            pending.append(entry);
+        }
+    }
 
-        if (!it.value().isObject()) {
-            continue;
+    // Objects are created in parallel, then added in document order
+    createObjects(pending, m_threadCount);
+    for (const PendingObject& entry : pending) {
+        if (entry.object) {
+            addObject(entry.name, entry.object);
         }
+    }
+
+    return true;
+}
+
+bool OcctGeo3DObjectSet::writeJson(QIODevice* device) const
+{
+    if (!device || !device->isWritable()) {
+        return false;
+    }
 
-        QJsonObject data = it.value().toObject();
+    // Same keys as toJson(); "objects" last so the header is readable with head
+    QByteArray header = "{\n\"version\": \"1.0\",\n\"objectCount\": "
+                        + QByteArray::number(m_objects.size()) + ",\n\"objects\": {";
+    bool ok = device->write(header) == header.size();
+
+    for (int index = 0; ok && index < m_objects.size(); ++index) {
+        QByteArray entry = (index == 0) ? "\n" : ",\n";
+        entry += jsonString(nameAt(index));
+        entry += ": ";
+        entry += QJsonDocument(m_objects[index]->toJson()).toJson(QJsonDocument::Compact);
+        ok = device->write(entry) == entry.size();
+    }
+
+    ok = ok && device->write("\n}\n}\n") == 5;
+    return ok;
+}
 
-        // Use factory method to create object
-        OcctGeo3DObject* object = OcctGeo3DObject::createFromJson(data);
-        if (object) {
-            addObject(name, object);
+bool OcctGeo3DObjectSet::readJson(QIODevice* device)
+{
+    clear();
+    if (!device || !device->isReadable()) {
+        return false;
+    }
+
+    JsonScanner scanner(device);
+    bool hasVersion = false;
+    bool hasObjects = false;
+    bool ok = scanner.expect('{');
+
+    // Entries are parsed and created in parallel batches, then added in order
+    QVector<PendingObject> batch;
+    auto flushBatch = [this, &batch]() {
+        createObjects(batch, m_threadCount);
+        for (const PendingObject& entry : batch) {
+            if (entry.object) {
+                addObject(entry.name, entry.object);
+            }
+        }
+        batch.clear();
+    };
+
+    // Top-level members
+    while (ok && !scanner.expect('}')) {
+        QString key;
+        ok = scanner.readKey(key);
+        if (!ok) {
+            break;
+        }
+
+        if (key == "objects") {
+            hasObjects = ok = scanner.expect('{');
+            while (ok && !scanner.expect('}')) {
+                PendingObject entry;
+                ok = scanner.readKey(entry.name) && scanner.readValue(entry.text);
+                if (!ok) {
+                    break;
+                }
+
+                batch.append(entry);
+                if (batch.size() >= kJsonBatchSize) {
+                    flushBatch();
+                }
+
+                if (scanner.peek() == ',') {
+                    scanner.expect(',');
+                }
+            }
+        } else {
+            QByteArray raw;
+            ok = scanner.readValue(raw);
+            hasVersion = hasVersion || key == "version";
+        }
+
+        if (ok && scanner.peek() == ',') {
+            scanner.expect(',');
         }
     }
 
+    flushBatch();
+
+    if (!ok || !hasVersion || !hasObjects) {
+        qWarning() << "Invalid or truncated JSON object set";
+        clear();
+        return false;
+    }
+
     return true;
 }
 
 bool OcctGeo3DObjectSet::saveToFile(const QString& filePath) const
 {
-    QJsonObject json = toJson();
-    QJsonDocument doc(json);
-
     QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly)) {
         qWarning() << "Could not open file for writing:" << filePath;
         return false;
     }
 
-    qint64 bytesWritten = file.write(doc.toJson());
+    bool ok = writeJson(&file);
     file.close();
 
-    if (bytesWritten == -1) {
+    if (!ok) {
         qWarning() << "Error writing to file:" << filePath;
         return false;
     }
@@ -334,18 +1036,208 @@ bool OcctGeo3DObjectSet::loadFromFile(const QString& filePath)
         return false;
     }
 
-    QByteArray data = file.readAll();
+    // Binary files are recognised by their magic
+    if (file.peek(sizeof(kBinaryMagic)) == QByteArray(kBinaryMagic, sizeof(kBinaryMagic))) {
+        file.close();
+        return loadFromBinaryFile(filePath);
+    }
+
+    bool ok = readJson(&file);
     file.close();
 
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    if (!ok) {
+        qWarning() << "Could not load object set:" << filePath;
+    }
 
-    if (error.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error:" << error.errorString();
+    return ok;
+}
+
+bool OcctGeo3DObjectSet::saveToBinaryFile(const QString& filePath) const
+{
+    // Type table and records
+    QStringList typeNames;
+    QVector<ObjectRecord> records;
+    QByteArray names;
+    records.reserve(m_objects.size());
+
+    for (int index = 0; index < m_objects.size(); ++index) {
+        const OcctGeo3DObject* object = m_objects[index];
+
+        QString typeName = object->getObjectType();
+        int typeIndex = typeNames.indexOf(typeName);
+        if (typeIndex < 0) {
+            if (typeName.toUtf8().size() >= int(sizeof(TypeEntry::name))) {
+                qWarning() << "Type name too long for binary format:" << typeName;
+                return false;
+            }
+            typeIndex = typeNames.size();
+            typeNames.append(typeName);
+        }
+
+        ObjectRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.typeIndex = typeIndex;
+        record.flags = (object->isVisible() ? RecordVisible : 0)
+                       | (object->isShowEdges() ? RecordShowEdges : 0);
+
+        QByteArray name = nameAt(index).toUtf8();
+        record.nameOffset = names.size();
+        record.nameLength = name.size();
+        names.append(name);
+
+        QVector3D position = object->getPosition();
+        QVector3D rotation = object->getRotation();
+        QVector3D scale = object->getScale();
+        for (int k = 0; k < 3; ++k) {
+            record.position[k] = position[k];
+            record.rotation[k] = rotation[k];
+            record.scale[k] = scale[k];
+        }
+
+        record.diffuse = packColor(object->getDiffuseColor());
+        record.ambient = packColor(object->getAmbientColor());
+        record.specular = packColor(object->getSpecularColor());
+        record.edgeColor = packColor(object->getEdgeColor());
+        record.shininess = object->getShininess();
+        record.opacity = object->getOpacity();
+        record.edgeWidth = object->getEdgeWidth();
+        record.dimensionCount = object->writeDimensions(record.dimensions);
+
+        records.append(record);
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.version = kBinaryVersion;
+    header.byteOrderMark = kByteOrderMark;
+    header.typeCount = typeNames.size();
+    header.objectCount = records.size();
+    header.typeTableOffset = alignTo8(sizeof(FileHeader));
+    header.recordsOffset = alignTo8(header.typeTableOffset + header.typeCount * sizeof(TypeEntry));
+    header.namesOffset = alignTo8(header.recordsOffset + header.objectCount * sizeof(ObjectRecord));
+    header.namesSize = names.size();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not open file for writing:" << filePath;
+        return false;
+    }
+
+    auto writeAt = [&file](quint64 offset, const void* data, qint64 size) {
+        // Pads the gap before an aligned section with zeros
+        if (quint64(file.pos()) < offset) {
+            file.write(QByteArray(int(offset - file.pos()), '\0'));
+        }
+        return file.write(static_cast<const char*>(data), size) == size;
+    };
+
+    bool ok = writeAt(0, &header, sizeof(header));
+    for (int k = 0; ok && k < typeNames.size(); ++k) {
+        TypeEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        QByteArray name = typeNames[k].toUtf8();
+        std::memcpy(entry.name, name.constData(), name.size());
+        ok = writeAt(header.typeTableOffset + k * sizeof(TypeEntry), &entry, sizeof(entry));
+    }
+    ok = ok && writeAt(header.recordsOffset, records.constData(), records.size() * qint64(sizeof(ObjectRecord)));
+    ok = ok && writeAt(header.namesOffset, names.constData(), names.size());
+    file.close();
+
+    if (!ok) {
+        qWarning() << "Error writing to file:" << filePath;
         return false;
     }
 
-    return fromJson(doc.object());
+    return true;
+}
+
+bool OcctGeo3DObjectSet::loadFromBinaryFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open file for reading:" << filePath;
+        return false;
+    }
+
+    const qint64 fileSize = file.size();
+    if (fileSize < qint64(sizeof(FileHeader))) {
+        qWarning() << "Binary object set too small:" << filePath;
+        return false;
+    }
+
+    uchar* data = file.map(0, fileSize);
+    if (!data) {
+        qWarning() << "Could not map file:" << filePath;
+        return false;
+    }
+
+    // The mapping is page-aligned and the section offsets are checked to be
+    // multiples of 8 below, so the sections can be read in place
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+    if (std::memcmp(header->magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0
+        || header->byteOrderMark != kByteOrderMark
+        || header->version != kBinaryVersion) {
+        qWarning() << "Unsupported binary object set (magic, byte order or version):" << filePath;
+        file.unmap(data);
+        return false;
+    }
+
+    if (!isValidSection(header->typeTableOffset, header->typeCount, sizeof(TypeEntry), fileSize)
+        || !isValidSection(header->recordsOffset, header->objectCount, sizeof(ObjectRecord), fileSize)
+        || !isValidSection(header->namesOffset, header->namesSize, 1, fileSize)) {
+        qWarning() << "Truncated or corrupt binary object set:" << filePath;
+        file.unmap(data);
+        return false;
+    }
+
+    const TypeEntry* types = reinterpret_cast<const TypeEntry*>(data + header->typeTableOffset);
+    const ObjectRecord* records = reinterpret_cast<const ObjectRecord*>(data + header->recordsOffset);
+    const char* names = reinterpret_cast<const char*>(data + header->namesOffset);
+
+    QStringList typeNames;
+    for (quint32 k = 0; k < header->typeCount; ++k) {
+        typeNames.append(QString::fromUtf8(types[k].name, qstrnlen(types[k].name, sizeof(TypeEntry::name))));
+    }
+
+    clear();
+
+    for (quint32 k = 0; k < header->objectCount; ++k) {
+        const ObjectRecord& record = records[k];
+        if (record.typeIndex >= header->typeCount
+            || quint64(record.nameOffset) + record.nameLength > header->namesSize) {
+            continue;
+        }
+
+        OcctGeo3DObject* object = OcctGeo3DObject::createObject(typeNames[record.typeIndex]);
+        if (!object) {
+            continue;
+        }
+
+        if (!object->readDimensions(record.dimensions,
+                                    qMin<int>(record.dimensionCount, OcctGeo3DObject::MaxBinaryDimensions))) {
+            delete object;
+            continue;
+        }
+
+        object->setPosition(record.position[0], record.position[1], record.position[2]);
+        object->setRotation(record.rotation[0], record.rotation[1], record.rotation[2]);
+        object->setScale(record.scale[0], record.scale[1], record.scale[2]);
+        object->setDiffuseColor(unpackColor(record.diffuse));
+        object->setAmbientColor(unpackColor(record.ambient));
+        object->setSpecularColor(unpackColor(record.specular));
+        object->setShininess(record.shininess);
+        object->setOpacity(record.opacity);
+        object->setVisible(record.flags & RecordVisible);
+        object->setShowEdges(record.flags & RecordShowEdges);
+        object->setEdgeColor(unpackColor(record.edgeColor));
+        object->setEdgeWidth(record.edgeWidth);
+
+        addObject(QString::fromUtf8(names + record.nameOffset, record.nameLength), object);
+    }
+
+    file.unmap(data);
+    return true;
 }
 
 TopoDS_Compound OcctGeo3DObjectSet::getAllShapesCompound() const
@@ -355,13 +1247,11 @@ TopoDS_Compound OcctGeo3DObjectSet::getAllShapesCompound() const
     builder.MakeCompound(compound);
 
     // Add all object shapes to compound
-    for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
-        OcctGeo3DObject* obj = it.value();
-        if (obj) {
-            TopoDS_Shape shape = obj->getTransformedShape();
-            if (!shape.IsNull()) {
-                builder.Add(compound, shape);
-            }
+    for (OcctGeo3DObject* obj : m_objects) {
+        obj->buildShape();
+        TopoDS_Shape shape = obj->getTransformedShape();
+        if (!shape.IsNull()) {
+            builder.Add(compound, shape);
         }
     }
 
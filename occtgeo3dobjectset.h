@@ -6,12 +6,14 @@
 #ifndef OCCTGEO3DOBJECTSET_H
 #define OCCTGEO3DOBJECTSET_H
 
-#include <QMap>
+#include <QHash>
 #include <QString>
 #include <QStringList>
 #include <QColor>
 #include <QVector3D>
 #include <QJsonObject>
+#include <QIODevice>
+#include <QVector>
 
 #include <AIS_InteractiveContext.hxx>
 #include <TopoDS_Compound.hxx>
@@ -24,9 +26,17 @@ class OcctGeo3DObject;
  * @brief A collection class for managing multiple OcctGeo3DObject instances
  *
  * The OcctGeo3DObjectSet class provides a convenient way to manage a collection of
- * OpenCASCADE-based 3D objects using a QMap with string keys. It offers functionality
- * for adding, removing, and manipulating multiple 3D objects as a group, with
- * OpenCASCADE AIS context integration for rendering.
+ * OpenCASCADE-based 3D objects. It offers functionality for adding, removing, and
+ * manipulating multiple 3D objects as a group, with OpenCASCADE AIS context
+ * integration for rendering.
+ *
+ * Objects are stored densely in a contiguous array, so bulk operations iterate
+ * plain pointers, and are addressed by integer ObjectHandle values that stay
+ * valid until the object is removed (removal swaps the last object into the
+ * hole). Objects may carry a structured ObjectKey (zone, radial, vertical
+ * index) and/or a name; grid cells added by key need no string at all, their
+ * names are derived from the key when asked for. The name and key lookup
+ * tables are hash indexes built on first use.
  *
  * The class automatically manages memory for the objects it contains and provides both
  * individual object access and bulk operations on all objects in the set.
@@ -44,25 +54,138 @@ public:
      */
     ~OcctGeo3DObjectSet();
 
+    /**
+     * @brief Integer handle of an object in the set
+     *
+     * Valid until the object is removed; the handle of a removed object may
+     * be reused by a later addObject().
+     */
+    typedef int ObjectHandle;
+    static const ObjectHandle InvalidHandle = -1;
+
+    /**
+     * @brief Structured key of a grid cell
+     */
+    struct ObjectKey
+    {
+        int zone = -1;      // Negative: no key
+        int radial = 0;
+        int vertical = 0;
+
+        bool isValid() const { return zone >= 0; }
+        bool operator==(const ObjectKey& other) const
+        {
+            return zone == other.zone && radial == other.radial && vertical == other.vertical;
+        }
+    };
+
+    /**
+     * @brief Who deletes an object added to the set
+     */
+    enum Ownership {
+        SetOwnership,       // Deleted by the set if ownsObjects() (default)
+        ExternalOwnership   // Never deleted by the set, e.g. arena-allocated cells
+    };
+
     // Object management
-    void addObject(const QString& name, OcctGeo3DObject* object);
+
+    /**
+     * @brief Adds an object without a name
+     *
+     * The fast path for bulk insertion: no string is created and no index is
+     * consulted. Keys are expected to be unique; this is not checked.
+     *
+     * @param object Object to add
+     * @param key Optional structured key
+     * @param ownership Whether the set may delete the object
+     * @return Handle of the object, or InvalidHandle for a null object
+     */
+    ObjectHandle addObject(OcctGeo3DObject* object, const ObjectKey& key = ObjectKey(),
+                           Ownership ownership = SetOwnership);
+
+    /**
+     * @brief Adds a named object, replacing any object with the same name
+     * @return Handle of the object, or InvalidHandle for a null object
+     */
+    ObjectHandle addObject(const QString& name, OcctGeo3DObject* object,
+                           Ownership ownership = SetOwnership);
+
+    bool removeObject(ObjectHandle handle);
     bool removeObject(const QString& name);
     void clear();
 
+    /**
+     * @brief Reserves storage for a number of objects
+     */
+    void reserve(int count);
+
+    /**
+     * @brief Sets whether removeObject(), clear() and the destructor delete objects
+     *
+     * Applies to objects added with SetOwnership; ExternalOwnership objects
+     * are never deleted.
+     *
+     * @param owns false for sets that only reference objects owned elsewhere
+     */
+    void setOwnsObjects(bool owns);
+    bool ownsObjects() const;
+
     // Object access
+    OcctGeo3DObject* getObject(ObjectHandle handle) const;
     OcctGeo3DObject* getObject(const QString& name) const;
+    OcctGeo3DObject* getObject(const ObjectKey& key) const;
+
+    /**
+     * @brief Looks up an object by name
+     *
+     * Builds the name index on first use (deriving the names of keyed
+     * objects), so the first call is O(n) and later calls O(1).
+     *
+     * @return Handle, or InvalidHandle if not found
+     */
+    ObjectHandle findObject(const QString& name) const;
+
+    /**
+     * @brief Looks up an object by key (key index built on first use)
+     * @return Handle, or InvalidHandle if not found
+     */
+    ObjectHandle findObject(const ObjectKey& key) const;
+
+    bool contains(ObjectHandle handle) const;
     bool contains(const QString& name) const;
+
+    /**
+     * @brief Gets the name of an object
+     *
+     * Objects added by key only get getZonePrefix(zone) + "r{radial}_z{vertical}".
+     */
+    QString getName(ObjectHandle handle) const;
+    ObjectKey getKey(ObjectHandle handle) const;
+    Ownership getOwnership(ObjectHandle handle) const;
+
+    /**
+     * @brief Sets the prefix of derived names in a zone (default "zone{zone}_")
+     */
+    void setZonePrefix(int zone, const QString& prefix);
+    QString getZonePrefix(int zone) const;
+
+    /**
+     * @brief Gets all names in storage order
+     */
     QStringList getObjectNames() const;
     int count() const;
     bool isEmpty() const;
 
-    // Iteration support
-    QMap<QString, OcctGeo3DObject*>::iterator begin();
-    QMap<QString, OcctGeo3DObject*>::iterator end();
-    QMap<QString, OcctGeo3DObject*>::const_iterator begin() const;
-    QMap<QString, OcctGeo3DObject*>::const_iterator end() const;
-    QMap<QString, OcctGeo3DObject*>::const_iterator constBegin() const;
-    QMap<QString, OcctGeo3DObject*>::const_iterator constEnd() const;
+    // Dense access by position, 0 <= index < count()
+    ObjectHandle handleAt(int index) const;
+    OcctGeo3DObject* objectAt(int index) const;
+    const QVector<OcctGeo3DObject*>& getObjects() const;
+
+    // Iteration support (over the objects, in storage order)
+    QVector<OcctGeo3DObject*>::const_iterator begin() const;
+    QVector<OcctGeo3DObject*>::const_iterator end() const;
+    QVector<OcctGeo3DObject*>::const_iterator constBegin() const;
+    QVector<OcctGeo3DObject*>::const_iterator constEnd() const;
 
     // OpenCASCADE AIS context integration
 
@@ -90,6 +213,68 @@ public:
      */
     void updateViewer(const Handle(AIS_InteractiveContext)& context);
 
+    /**
+     * @brief Enables or disables batched (deferred) updates for all objects
+     *
+     * While enabled, setAll* and per-object setters only record dirty bits;
+     * objects added later inherit the mode. Call flush() to apply the changes.
+     *
+     * @param deferred true to batch updates until flush()
+     */
+    void setDeferredUpdates(bool deferred);
+    bool isDeferredUpdates() const;
+
+    /**
+     * @brief Applies all pending material, edge, transform and visibility changes
+     *
+     * Each object with pending changes is updated and redisplayed once, then
+     * the viewer is updated.
+     *
+     * @param context The AIS interactive context
+     */
+    void flush(const Handle(AIS_InteractiveContext)& context);
+
+    /**
+     * @brief Sets the number of worker threads for parallel stages (meshAll(), fromJson(), readJson())
+     * @param threadCount Number of threads, or 0 to use QThread::idealThreadCount()
+     */
+    void setThreadCount(int threadCount);
+    int getThreadCount() const;
+
+    /**
+     * @brief Sets the tessellation tolerances used by meshAll()
+     * @param linearDeflection Maximum chordal deviation in model units
+     * @param angularDeflection Maximum angular deviation in radians
+     */
+    void setMeshDeflection(double linearDeflection, double angularDeflection = 0.5);
+    double getLinearDeflection() const;
+    double getAngularDeflection() const;
+
+    /**
+     * @brief Tessellates all objects in parallel before display
+     *
+     * Builds missing shapes, then runs BRepMesh_IncrementalMesh once per
+     * distinct shape (objects sharing a prototype shape are meshed once) on a
+     * worker pool. The triangulation is stored in the shapes and the objects
+     * are marked pre-meshed, so later display, redisplay and colour changes
+     * reuse it instead of meshing lazily on the GUI thread.
+     *
+     * @return Time spent meshing in milliseconds
+     */
+    qint64 meshAll();
+
+    /**
+     * @brief Gets the time spent in the last meshAll() call
+     * @return Milliseconds
+     */
+    qint64 getLastMeshTime() const;
+
+    /**
+     * @brief Gets the time spent in the last displayAll() call
+     * @return Milliseconds (excludes meshAll())
+     */
+    qint64 getLastDisplayTime() const;
+
     // Visibility control
     void setAllVisible(bool visible);
     void setObjectVisible(const QString& name, bool visible);
@@ -103,17 +288,95 @@ public:
     void setAllEdgeWidth(float width);
     void setAllOpacity(float opacity);
 
-    // Direct map access
-    const QMap<QString, OcctGeo3DObject*>& getObjectMap() const;
+    /**
+     * @brief Temporarily renders all objects opaque
+     *
+     * Used by the cutaway view, where a clipping plane replaces transparency.
+     * The current opacities are saved and restored by setOpaque(false).
+     *
+     * @param opaque true to force full opacity, false to restore
+     */
+    void setOpaque(bool opaque);
+    bool isOpaque() const;
 
     // JSON Serialization
     QJsonObject toJson() const;
+
+    /**
+     * @brief Replaces the set with the objects of a JSON document
+     *
+     * Objects are created (factory lookup and OcctGeo3DObject::fromJson())
+     * in parallel on up to getThreadCount() threads and then added in
+     * document order.
+     */
     bool fromJson(const QJsonObject& json);
 
+    /**
+     * @brief Writes the set as JSON, one object at a time
+     *
+     * Produces the same document as toJson() without building it in memory:
+     * each object is serialised and written on its own line, so peak memory
+     * is that of a single object regardless of the set size.
+     *
+     * @param device Open, writable device
+     * @return true on success
+     */
+    bool writeJson(QIODevice* device) const;
+
+    /**
+     * @brief Reads a JSON set incrementally
+     *
+     * The device is read in fixed-size chunks and the entries of "objects"
+     * are collected in batches of a few thousand; each batch is parsed and
+     * created on the worker pool, then added in document order. Memory is
+     * bounded by one batch. Accepts anything fromJson() accepts, in any key
+     * order.
+     *
+     * @param device Open, readable device
+     * @return true on success; on failure the set is left empty
+     */
+    bool readJson(QIODevice* device);
+
     // File I/O
+
+    /**
+     * @brief Saves the set as JSON (streamed with writeJson())
+     */
     bool saveToFile(const QString& filePath) const;
+
+    /**
+     * @brief Loads a set saved by saveToFile() or saveToBinaryFile()
+     *
+     * The format is detected from the file header.
+     */
     bool loadFromFile(const QString& filePath);
 
+    /**
+     * @brief Saves the set in the versioned binary format
+     *
+     * The file holds a header, a table of object type names and one
+     * fixed-size record per object (type index, transform, RGBA-packed
+     * material, edge settings and up to OcctGeo3DObject::MaxBinaryDimensions
+     * type-specific dimensions), followed by the UTF-8 object names. Values
+     * are stored in host byte order; loading a file with a different byte
+     * order is rejected.
+     *
+     * @param filePath Output file
+     * @return true on success
+     */
+    bool saveToBinaryFile(const QString& filePath) const;
+
+    /**
+     * @brief Loads a set saved by saveToBinaryFile()
+     *
+     * The file is memory-mapped and the records are read in place; there is
+     * no per-field parsing or key lookup.
+     *
+     * @param filePath Input file
+     * @return true on success
+     */
+    bool loadFromBinaryFile(const QString& filePath);
+
     /**
      * @brief Exports all objects to STEP file format
      * @param filename Path to output STEP file (e.g., "output.step")
@@ -128,8 +391,47 @@ public:
     TopoDS_Compound getAllShapesCompound() const;
 
 private:
-    QMap<QString, OcctGeo3DObject*> m_objects;
+    int indexOf(ObjectHandle handle) const;
+    QString nameAt(int index) const;
+
+    // Dense storage, one entry per object at the same index in each vector;
+    // an empty name means "derived from the key"
+    QVector<OcctGeo3DObject*> m_objects;
+    QVector<ObjectKey> m_keys;
+    QVector<QString> m_names;
+    QVector<ObjectHandle> m_handles;
+    QVector<Ownership> m_ownership;
+
+    // Handle -> index in the dense vectors, -1 for free handles
+    QVector<int> m_slots;
+    QVector<ObjectHandle> m_freeHandles;
+
+    QHash<int, QString> m_zonePrefixes;
+
+    // Lookup indexes, built on demand
+    mutable QHash<QString, ObjectHandle> m_nameIndex;
+    mutable QHash<ObjectKey, ObjectHandle> m_keyIndex;
+    mutable bool m_nameIndexBuilt;
+    mutable bool m_keyIndexBuilt;
+
     bool m_ownsObjects;
+    bool m_deferredUpdates;
+
+    // Opacities saved by setOpaque(true)
+    QHash<ObjectHandle, float> m_savedOpacities;
+    bool m_opaque;
+
+    // Parallel meshing
+    int m_threadCount;
+    double m_linearDeflection;
+    double m_angularDeflection;
+    qint64 m_lastMeshTime;
+    qint64 m_lastDisplayTime;
 };
 
+inline size_t qHash(const OcctGeo3DObjectSet::ObjectKey& key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.zone, key.radial, key.vertical);
+}
+
 #endif // OCCTGEO3DOBJECTSET_H
@@ -0,0 +1,292 @@
+/**
+ * @file occtgridpresentation.cpp
+ * @brief Implementation of the OcctGridPresentation class
+ */
+
+#include "occtgridpresentation.h"
+
+#include <QDebug>
+
+#include <Graphic3d_AttribBuffer.hxx>
+#include <Graphic3d_Group.hxx>
+#include <Prs3d_Presentation.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <StdSelect_ViewerSelector3d.hxx>
+
+#include <algorithm>
+
+IMPLEMENT_STANDARD_RTTIEXT(OcctGridPresentation, AIS_InteractiveObject)
+
+OcctGridPresentation::OcctGridPresentation()
+    : m_mesher(24)
+    , m_arraysValid(false)
+{
+    // Per-vertex colours modulate a neutral plastic material
+    Handle(Prs3d_ShadingAspect) shadingAspect = new Prs3d_ShadingAspect();
+    shadingAspect->SetMaterial(Graphic3d_NOM_PLASTIC);
+    shadingAspect->SetColor(Quantity_NOC_WHITE);
+    myDrawer->SetShadingAspect(shadingAspect);
+
+    SetDisplayMode(0);
+}
+
+void OcctGridPresentation::setZone(Zone zone, int nr, int nz, const QVector<Cell>& cells)
+{
+    if (zone < 0 || zone >= ZoneCount) {
+        return;
+    }
+
+    ZoneData& data = m_zones[zone];
+    data.nr = nr;
+    data.nz = nz;
+    data.cells = cells;
+
+    data.colors.resize(cells.size());
+    for (int k = 0; k < cells.size(); ++k) {
+        const Quantity_Color& color = cells[k].color;
+        data.colors[k] = Graphic3d_Vec4ub(static_cast<Standard_Byte>(color.Red() * 255.0),
+                                          static_cast<Standard_Byte>(color.Green() * 255.0),
+                                          static_cast<Standard_Byte>(color.Blue() * 255.0),
+                                          255);
+    }
+
+    m_arraysValid = false;
+    SetToUpdate();
+}
+
+bool OcctGridPresentation::setCellField(Zone zone, const float* values, int count,
+                                        const OcctColorMap& colorMap)
+{
+    if (!values || !checkFieldSize(zone, count)) {
+        return false;
+    }
+
+    ZoneData& data = m_zones[zone];
+    for (int k = 0; k < count; ++k) {
+        data.colors[k] = colorMap.map(values[k]);
+    }
+
+    // Not computed yet: buildArrays() picks up the new colours
+    if (m_arraysValid && !data.triangles.IsNull()) {
+        writeCellColors(data);
+    }
+
+    return true;
+}
+
+bool OcctGridPresentation::setCellColors(Zone zone, const Graphic3d_Vec4ub* colors, int count)
+{
+    if (!colors || !checkFieldSize(zone, count)) {
+        return false;
+    }
+
+    ZoneData& data = m_zones[zone];
+    std::copy(colors, colors + count, data.colors.begin());
+
+    if (m_arraysValid && !data.triangles.IsNull()) {
+        writeCellColors(data);
+    }
+
+    return true;
+}
+
+bool OcctGridPresentation::checkFieldSize(Zone zone, int count) const
+{
+    if (zone < 0 || zone >= ZoneCount) {
+        return false;
+    }
+
+    if (count != m_zones[zone].cells.size()) {
+        qWarning() << "OcctGridPresentation: field has" << count << "values, zone has"
+                   << m_zones[zone].cells.size() << "cells";
+        return false;
+    }
+
+    return true;
+}
+
+void OcctGridPresentation::setAngularSegments(int segments)
+{
+    if (m_mesher.getAngularSegments() != qMax(3, segments)) {
+        m_mesher.setAngularSegments(segments);
+        m_arraysValid = false;
+        SetToUpdate();
+    }
+}
+
+int OcctGridPresentation::getAngularSegments() const
+{
+    return m_mesher.getAngularSegments();
+}
+
+int OcctGridPresentation::getCellCount(Zone zone) const
+{
+    if (zone < 0 || zone >= ZoneCount) {
+        return 0;
+    }
+    return m_zones[zone].cells.size();
+}
+
+int OcctGridPresentation::getTriangleCount() const
+{
+    int count = 0;
+    for (const ZoneData& data : m_zones) {
+        count += data.cells.size() * trianglesPerCell();
+    }
+    return count;
+}
+
+int OcctGridPresentation::trianglesPerCell() const
+{
+    return m_mesher.trianglesPerCell();
+}
+
+bool OcctGridPresentation::cellFromTriangle(Zone zone, int triangleIndex, CellId& cell) const
+{
+    if (zone < 0 || zone >= ZoneCount || triangleIndex < 0) {
+        return false;
+    }
+
+    const ZoneData& data = m_zones[zone];
+    int cellIndex = triangleIndex / trianglesPerCell();
+    if (data.nz <= 0 || cellIndex >= data.cells.size()) {
+        return false;
+    }
+
+    cell.zone = zone;
+    cell.radialIndex = cellIndex / data.nz;
+    cell.verticalIndex = cellIndex % data.nz;
+    return true;
+}
+
+bool OcctGridPresentation::detectedCell(const Handle(AIS_InteractiveContext)& context, CellId& cell) const
+{
+    if (context.IsNull() || !context->HasDetected() || context->DetectedInteractive().get() != this) {
+        return false;
+    }
+
+    Handle(Select3D_SensitivePrimitiveArray) sensitive =
+        Handle(Select3D_SensitivePrimitiveArray)::DownCast(context->MainSelector()->DetectedEntity());
+    if (sensitive.IsNull()) {
+        return false;
+    }
+
+    for (int zone = 0; zone < ZoneCount; ++zone) {
+        if (m_zones[zone].sensitive == sensitive) {
+            return cellFromTriangle(static_cast<Zone>(zone), sensitive->LastDetectedElement(), cell);
+        }
+    }
+
+    return false;
+}
+
+Standard_Boolean OcctGridPresentation::AcceptDisplayMode(const Standard_Integer theMode) const
+{
+    return theMode == 0;
+}
+
+void OcctGridPresentation::buildArrays()
+{
+    if (m_arraysValid) {
+        return;
+    }
+
+    const int verticesPerCell = m_mesher.verticesPerCell();
+    for (ZoneData& data : m_zones) {
+        data.triangles.Nullify();
+        if (data.cells.isEmpty()) {
+            continue;
+        }
+
+        // Mutable attributes allow setCellField() to update colours in place
+        data.triangles = new Graphic3d_ArrayOfTriangles(
+            data.cells.size() * verticesPerCell,
+            data.cells.size() * trianglesPerCell() * 3,
+            Graphic3d_ArrayFlags_VertexNormal | Graphic3d_ArrayFlags_VertexColor
+                | Graphic3d_ArrayFlags_AttribsMutable);
+
+        for (int k = 0; k < data.cells.size(); ++k) {
+            const Cell& cell = data.cells[k];
+            m_mesher.appendToArray(data.triangles, cell.innerRadius, cell.outerRadius,
+                                   cell.zBottom, cell.zTop, data.colors[k]);
+        }
+    }
+
+    m_arraysValid = true;
+}
+
+void OcctGridPresentation::writeCellColors(ZoneData& data)
+{
+    // Each cell owns a contiguous block of vertices (1-based in the array)
+    const int verticesPerCell = m_mesher.verticesPerCell();
+    int vertex = 1;
+    for (const Graphic3d_Vec4ub& color : data.colors) {
+        for (int v = 0; v < verticesPerCell; ++v) {
+            data.triangles->SetVertexColor(vertex++, color);
+        }
+    }
+
+    // Re-upload only the colour attribute on the next redraw
+    Handle(Graphic3d_AttribBuffer) buffer =
+        Handle(Graphic3d_AttribBuffer)::DownCast(data.triangles->Attributes());
+    if (buffer.IsNull()) {
+        return;
+    }
+    for (Standard_Integer attrib = 0; attrib < buffer->NbAttributes; ++attrib) {
+        if (buffer->Attribute(attrib).Id == Graphic3d_TOA_COLOR) {
+            buffer->Invalidate(attrib);
+        }
+    }
+}
+
+void OcctGridPresentation::Compute(const Handle(PrsMgr_PresentationManager)& /*thePrsMgr*/,
+                                   const Handle(Prs3d_Presentation)& thePrs,
+                                   const Standard_Integer theMode)
+{
+    if (theMode != 0) {
+        return;
+    }
+
+    buildArrays();
+
+    // One group (and one draw call) per zone
+    for (const ZoneData& data : m_zones) {
+        if (data.triangles.IsNull()) {
+            continue;
+        }
+
+        // Every cell is a closed shell, which lets clipping planes cap the grid
+        Handle(Graphic3d_Group) group = thePrs->NewGroup();
+        group->SetClosed(true);
+        group->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+        group->AddPrimitiveArray(data.triangles);
+    }
+}
+
+void OcctGridPresentation::ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                                            const Standard_Integer theMode)
+{
+    if (theMode != 0) {
+        return;
+    }
+
+    buildArrays();
+
+    Handle(SelectMgr_EntityOwner) owner = new SelectMgr_EntityOwner(this);
+    for (ZoneData& data : m_zones) {
+        data.sensitive.Nullify();
+        if (data.triangles.IsNull()) {
+            continue;
+        }
+
+        // Element detection reports the picked triangle, see detectedCell()
+        data.sensitive = new Select3D_SensitivePrimitiveArray(owner);
+        data.sensitive->SetDetectElements(true);
+        data.sensitive->InitTriangulation(data.triangles->Attributes(),
+                                          data.triangles->Indices(),
+                                          TopLoc_Location());
+        theSel->Add(data.sensitive);
+    }
+}
@@ -0,0 +1,187 @@
+/**
+ * @file occtgridpresentation.h
+ * @brief Header file for the OcctGridPresentation class
+ */
+
+#ifndef OCCTGRIDPRESENTATION_H
+#define OCCTGRIDPRESENTATION_H
+
+#include <QVector>
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <Quantity_Color.hxx>
+#include <Select3D_SensitivePrimitiveArray.hxx>
+
+#include "occtcolormap.h"
+#include "occttubemesher.h"
+
+/**
+ * @class OcctGridPresentation
+ * @brief One AIS presentation for all annular cells of a drywell grid
+ *
+ * Instead of one AIS_Shape per tube, all cells of a zone are tessellated by
+ * OcctTubeMesher (no BRep involved) into a single Graphic3d_ArrayOfTriangles
+ * with per-vertex colours, so the viewer handles one presentation, a few draw
+ * calls and one sensitive entity per zone regardless of the number of cells.
+ *
+ * Cells are given per zone in the same order as OcctDrywellSystem stores its
+ * tubes (radial-major, see OcctDrywellSystem::getTubeIndex()). Each cell owns a
+ * fixed-size block of triangles, which lets a picked triangle be mapped back to
+ * its (zone, radial, vertical) cell.
+ *
+ * The vertex buffers are mutable: setCellField() rewrites only the colour
+ * attribute of each cell's vertex block and invalidates that attribute, so
+ * the GPU buffer is updated in place without recomputing the presentation.
+ */
+class OcctGridPresentation : public AIS_InteractiveObject
+{
+    DEFINE_STANDARD_RTTIEXT(OcctGridPresentation, AIS_InteractiveObject)
+
+public:
+    /**
+     * @brief Zones of the drywell grid, one triangle array each
+     */
+    enum Zone {
+        AggregateZone = 0,
+        BelowWellZone = 1,
+        ZoneCount
+    };
+
+    /**
+     * @brief Geometry and colour of one annular cell
+     */
+    struct Cell
+    {
+        float innerRadius;
+        float outerRadius;
+        float zTop;
+        float zBottom;
+        Quantity_Color color;
+    };
+
+    /**
+     * @brief Identifies a cell of the grid
+     */
+    struct CellId
+    {
+        Zone zone;
+        int radialIndex;
+        int verticalIndex;
+    };
+
+    /**
+     * @brief Default constructor
+     */
+    explicit OcctGridPresentation();
+
+    /**
+     * @brief Sets the cells of one zone
+     * @param zone Zone to set
+     * @param nr Number of radial cells
+     * @param nz Number of vertical cells
+     * @param cells nr * nz cells in radial-major order
+     * @note Call AIS_InteractiveContext::Redisplay() afterwards if displayed
+     */
+    void setZone(Zone zone, int nr, int nz, const QVector<Cell>& cells);
+
+    /**
+     * @brief Recolours the cells of one zone from a scalar field
+     *
+     * Only the colour attribute of the existing vertex buffer is rewritten;
+     * geometry, normals and selection are left untouched. If the presentation
+     * has not been computed yet the colours are used when it is.
+     *
+     * @param zone Zone to recolour
+     * @param values One value per cell in radial-major order
+     *               (OcctDrywellSystem::getTubeIndex() / getBelowWellTubeIndex())
+     * @param count Number of values, must equal getCellCount(zone)
+     * @param colorMap Maps values to colours
+     * @return false if the zone is invalid or count does not match
+     * @note The viewer must be redrawn afterwards (V3d_Viewer::Invalidate() + Redraw())
+     */
+    bool setCellField(Zone zone, const float* values, int count, const OcctColorMap& colorMap);
+
+    /**
+     * @brief Recolours the cells of one zone from precomputed colours
+     *
+     * Same in-place update as setCellField() for colours that were already
+     * mapped, e.g. on a worker thread by OcctFieldAnimator.
+     *
+     * @param zone Zone to recolour
+     * @param colors One colour per cell in radial-major order
+     * @param count Number of colours, must equal getCellCount(zone)
+     * @return false if the zone is invalid or count does not match
+     */
+    bool setCellColors(Zone zone, const Graphic3d_Vec4ub* colors, int count);
+
+    /**
+     * @brief Sets the number of segments used around the circumference
+     * @param segments Angular resolution (at least 3)
+     */
+    void setAngularSegments(int segments);
+    int getAngularSegments() const;
+
+    /**
+     * @brief Gets the number of cells of a zone
+     */
+    int getCellCount(Zone zone) const;
+
+    /**
+     * @brief Gets the total number of triangles of all zones
+     */
+    int getTriangleCount() const;
+
+    /**
+     * @brief Maps a triangle of a zone's array back to its cell
+     * @param zone Zone the triangle belongs to
+     * @param triangleIndex 0-based triangle index in the zone's array
+     * @param cell Receives the cell on success
+     * @return true if the triangle belongs to a cell of the zone
+     */
+    bool cellFromTriangle(Zone zone, int triangleIndex, CellId& cell) const;
+
+    /**
+     * @brief Gets the cell under the cursor after AIS_InteractiveContext::MoveTo()
+     * @param context The AIS interactive context this grid is displayed in
+     * @param cell Receives the detected cell on success
+     * @return true if a cell of this grid is currently detected
+     */
+    bool detectedCell(const Handle(AIS_InteractiveContext)& context, CellId& cell) const;
+
+    // AIS_InteractiveObject interface
+    Standard_Boolean AcceptDisplayMode(const Standard_Integer theMode) const override;
+
+protected:
+    void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                 const Handle(Prs3d_Presentation)& thePrs,
+                 const Standard_Integer theMode) override;
+
+    void ComputeSelection(const Handle(SelectMgr_Selection)& theSel,
+                          const Standard_Integer theMode) override;
+
+private:
+    struct ZoneData
+    {
+        int nr = 0;
+        int nz = 0;
+        QVector<Cell> cells;
+        QVector<Graphic3d_Vec4ub> colors;  // Current colour per cell
+        Handle(Graphic3d_ArrayOfTriangles) triangles;
+        Handle(Select3D_SensitivePrimitiveArray) sensitive;
+    };
+
+    void buildArrays();
+    bool checkFieldSize(Zone zone, int count) const;
+    void writeCellColors(ZoneData& data);
+    int trianglesPerCell() const;
+
+    ZoneData m_zones[ZoneCount];
+    OcctTubeMesher m_mesher;
+    bool m_arraysValid;
+};
+
+DEFINE_STANDARD_HANDLE(OcctGridPresentation, AIS_InteractiveObject)
+
+#endif // OCCTGRIDPRESENTATION_H
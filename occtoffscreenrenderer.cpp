@@ -0,0 +1,238 @@
+/**
+ * @file occtoffscreenrenderer.cpp
+ * @brief Implementation of the OcctOffscreenRenderer class
+ */
+
+#include "occtoffscreenrenderer.h"
+
+#include <QDebug>
+
+#include <OpenGl_GraphicDriver.hxx>
+#include <Image_AlienPixMap.hxx>
+#include <V3d_ImageDumpOptions.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <Quantity_Color.hxx>
+#include <Standard_Failure.hxx>
+#include <gp_Pln.hxx>
+
+#ifdef _WIN32
+#include <WNT_WClass.hxx>
+#include <WNT_Window.hxx>
+#elif defined(__APPLE__)
+#include <Cocoa_Window.hxx>
+#else
+#include <Xw_Window.hxx>
+#endif
+
+OcctOffscreenRenderer::OcctOffscreenRenderer(int width, int height)
+    : m_windowWidth(qMax(1, width))
+    , m_windowHeight(qMax(1, height))
+    , m_initialized(false)
+{
+}
+
+OcctOffscreenRenderer::~OcctOffscreenRenderer()
+{
+    if (!m_context.IsNull()) {
+        m_context->RemoveAll(Standard_False);
+    }
+    if (!m_view.IsNull()) {
+        m_view->Remove();
+    }
+}
+
+bool OcctOffscreenRenderer::initialize()
+{
+    if (m_initialized) {
+        return true;
+    }
+
+    try {
+        m_displayConnection = new Aspect_DisplayConnection();
+
+        // Frames are read back from offscreen buffers, never presented
+        Handle(OpenGl_GraphicDriver) graphicDriver = new OpenGl_GraphicDriver(m_displayConnection);
+        graphicDriver->ChangeOptions().buffersNoSwap = Standard_True;
+
+        m_viewer = new V3d_Viewer(graphicDriver);
+        m_viewer->SetDefaultLights();
+        m_viewer->SetLightOn();
+
+        m_view = m_viewer->CreateView();
+        m_view->SetImmediateUpdate(Standard_False);
+
+        // Hidden native window; it only provides the GL context
+#ifdef _WIN32
+        Handle(WNT_WClass) windowClass = new WNT_WClass("OcctOffscreenRenderer", DefWindowProcW,
+                                                        CS_VREDRAW | CS_HREDRAW, 0, 0,
+                                                        ::LoadCursor(NULL, IDC_ARROW));
+        Handle(WNT_Window) window = new WNT_Window("OcctOffscreenRenderer", windowClass, WS_POPUP,
+                                                   0, 0, m_windowWidth, m_windowHeight);
+#elif defined(__APPLE__)
+        Handle(Cocoa_Window) window = new Cocoa_Window("OcctOffscreenRenderer",
+                                                       0, 0, m_windowWidth, m_windowHeight);
+#else
+        Handle(Xw_Window) window = new Xw_Window(m_displayConnection, "OcctOffscreenRenderer",
+                                                 0, 0, m_windowWidth, m_windowHeight);
+#endif
+        window->SetVirtual(Standard_True);
+        m_view->SetWindow(window);
+
+        m_view->SetBackgroundColor(Quantity_NOC_GRAY30);
+        m_view->Camera()->SetProjectionType(Graphic3d_Camera::Projection_Perspective);
+
+        m_context = new AIS_InteractiveContext(m_viewer);
+        m_context->SetDisplayMode(AIS_Shaded, Standard_False);
+
+        // Vertical plane through the well axis for the section preset
+        m_sectionPlane = new Graphic3d_ClipPlane(gp_Pln(gp_Pnt(0.0, 0.0, 0.0), gp_Dir(0.0, 1.0, 0.0)));
+        m_sectionPlane->SetCapping(Standard_True);
+        m_sectionPlane->SetCappingColor(Quantity_Color(Quantity_NOC_GRAY70));
+        m_sectionPlane->SetOn(Standard_False);
+        m_view->AddClipPlane(m_sectionPlane);
+    } catch (const Standard_Failure& e) {
+        qWarning() << "OcctOffscreenRenderer: initialization failed:" << e.GetMessageString();
+        m_context.Nullify();
+        m_view.Nullify();
+        m_viewer.Nullify();
+        return false;
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+bool OcctOffscreenRenderer::isInitialized() const
+{
+    return m_initialized;
+}
+
+Handle(AIS_InteractiveContext) OcctOffscreenRenderer::getContext() const
+{
+    return m_context;
+}
+
+Handle(V3d_View) OcctOffscreenRenderer::getView() const
+{
+    return m_view;
+}
+
+void OcctOffscreenRenderer::setBackgroundColor(const QColor& color)
+{
+    if (!m_view.IsNull()) {
+        m_view->SetBackgroundColor(Quantity_Color(color.redF(), color.greenF(), color.blueF(),
+                                                  Quantity_TOC_RGB));
+    }
+}
+
+void OcctOffscreenRenderer::setCameraPreset(CameraPreset preset)
+{
+    if (m_view.IsNull()) {
+        return;
+    }
+
+    m_sectionPlane->SetOn(preset == SectionView ? Standard_True : Standard_False);
+
+    switch (preset) {
+    case TopView:
+        m_view->SetProj(V3d_Zpos);
+        break;
+    case SectionView:
+        // Looking at the cut face; the plane keeps the +Y half
+        m_view->SetProj(V3d_Yneg);
+        break;
+    case IsoView:
+    default:
+        m_view->SetProj(V3d_XposYposZpos);
+        break;
+    }
+
+    m_view->FitAll(0.01, Standard_False);
+    m_view->ZFitAll();
+}
+
+QImage OcctOffscreenRenderer::renderImage(int width, int height)
+{
+    if (m_view.IsNull() || width <= 0 || height <= 0) {
+        return QImage();
+    }
+
+    // ToPixMap renders into an offscreen framebuffer of exactly this size
+    Image_AlienPixMap pixMap;
+    V3d_ImageDumpOptions options;
+    options.Width = width;
+    options.Height = height;
+    options.BufferType = Graphic3d_BT_RGB;
+    options.StereoOptions = V3d_SDO_MONO;
+
+    if (!m_view->ToPixMap(pixMap, options)) {
+        qWarning() << "OcctOffscreenRenderer: rendering" << width << "x" << height << "failed";
+        return QImage();
+    }
+
+    QImage image(pixMap.Data(), static_cast<int>(pixMap.SizeX()), static_cast<int>(pixMap.SizeY()),
+                 static_cast<int>(pixMap.SizeRowBytes()), QImage::Format_RGB888);
+
+    // OpenGL read-back is bottom-up; copy() detaches from the pixmap memory
+    return pixMap.IsTopDown() ? image.copy() : image.mirrored();
+}
+
+bool OcctOffscreenRenderer::render(const RenderJob& job)
+{
+    setCameraPreset(job.preset);
+
+    QImage image = renderImage(job.width, job.height);
+    if (image.isNull()) {
+        return false;
+    }
+
+    if (!image.save(job.fileName)) {
+        qWarning() << "OcctOffscreenRenderer: cannot write" << job.fileName;
+        return false;
+    }
+
+    return true;
+}
+
+int OcctOffscreenRenderer::renderBatch(const QVector<RenderJob>& jobs)
+{
+    if (!initialize()) {
+        return 0;
+    }
+
+    int written = 0;
+    for (const RenderJob& job : jobs) {
+        if (render(job)) {
+            ++written;
+        }
+    }
+    return written;
+}
+
+QString OcctOffscreenRenderer::presetName(CameraPreset preset)
+{
+    switch (preset) {
+    case TopView:
+        return "top";
+    case SectionView:
+        return "section";
+    case IsoView:
+    default:
+        return "iso";
+    }
+}
+
+bool OcctOffscreenRenderer::presetFromName(const QString& name, CameraPreset& preset)
+{
+    const QString lower = name.trimmed().toLower();
+    if (lower == "iso") {
+        preset = IsoView;
+    } else if (lower == "top") {
+        preset = TopView;
+    } else if (lower == "section") {
+        preset = SectionView;
+    } else {
+        return false;
+    }
+    return true;
+}
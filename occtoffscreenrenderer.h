@@ -0,0 +1,132 @@
+/**
+ * @file occtoffscreenrenderer.h
+ * @brief Header file for the OcctOffscreenRenderer class
+ */
+
+#ifndef OCCTOFFSCREENRENDERER_H
+#define OCCTOFFSCREENRENDERER_H
+
+#include <QColor>
+#include <QImage>
+#include <QString>
+#include <QVector>
+
+#include <AIS_InteractiveContext.hxx>
+#include <Aspect_DisplayConnection.hxx>
+#include <Graphic3d_ClipPlane.hxx>
+#include <V3d_View.hxx>
+#include <V3d_Viewer.hxx>
+
+/**
+ * @class OcctOffscreenRenderer
+ * @brief Renders standard views to images without an on-screen window
+ *
+ * Owns one viewer, view and AIS context backed by a hidden (virtual) native
+ * window; every image is rendered into an offscreen framebuffer of the
+ * requested size with V3d_View::ToPixMap(), so the window size does not
+ * limit the resolution. Display objects once in getContext(), then render any
+ * number of presets and resolutions with renderBatch(); the viewer and the
+ * context are reused across frames.
+ *
+ * On Linux this needs an X display but no GPU: Xvfb with Mesa software GL
+ * (llvmpipe) is enough for batch nodes.
+ */
+class OcctOffscreenRenderer
+{
+public:
+    /**
+     * @brief Standard camera set-ups
+     */
+    enum CameraPreset {
+        IsoView,      // Axonometric view from +X +Y +Z
+        TopView,      // Looking down the well axis
+        SectionView   // Side view, sliced through the well axis by a capped plane
+    };
+
+    /**
+     * @brief One image to render
+     */
+    struct RenderJob
+    {
+        CameraPreset preset;
+        int width;
+        int height;
+        QString fileName;
+    };
+
+    /**
+     * @brief Constructor
+     * @param width Size of the hidden window (images may have any size)
+     * @param height Size of the hidden window
+     */
+    explicit OcctOffscreenRenderer(int width = 1024, int height = 768);
+
+    /**
+     * @brief Destructor
+     */
+    ~OcctOffscreenRenderer();
+
+    /**
+     * @brief Creates the graphic driver, viewer, view and context
+     * @return true on success; failures (e.g. no display) are reported with qWarning
+     */
+    bool initialize();
+    bool isInitialized() const;
+
+    Handle(AIS_InteractiveContext) getContext() const;
+    Handle(V3d_View) getView() const;
+
+    void setBackgroundColor(const QColor& color);
+
+    /**
+     * @brief Points the camera according to a preset and fits the scene
+     */
+    void setCameraPreset(CameraPreset preset);
+
+    /**
+     * @brief Renders the current camera into an image
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @return RGB image, or a null image on failure
+     */
+    QImage renderImage(int width, int height);
+
+    /**
+     * @brief Renders a preset and writes it to a file
+     * @param job Preset, size and file name (format from the extension, e.g. .png)
+     * @return true if the file was written
+     */
+    bool render(const RenderJob& job);
+
+    /**
+     * @brief Renders several jobs with the same viewer and context
+     * @return Number of files written
+     */
+    int renderBatch(const QVector<RenderJob>& jobs);
+
+    /**
+     * @brief Gets the name of a preset ("iso", "top", "section")
+     */
+    static QString presetName(CameraPreset preset);
+
+    /**
+     * @brief Parses a preset name
+     * @return true if the name is known
+     */
+    static bool presetFromName(const QString& name, CameraPreset& preset);
+
+private:
+    int m_windowWidth;
+    int m_windowHeight;
+    bool m_initialized;
+
+    Handle(Aspect_DisplayConnection) m_displayConnection;
+    Handle(V3d_Viewer) m_viewer;
+    Handle(V3d_View) m_view;
+    Handle(AIS_InteractiveContext) m_context;
+
+    // Enabled by SectionView only
+    Handle(Graphic3d_ClipPlane) m_sectionPlane;
+};
+
+#endif // OCCTOFFSCREENRENDERER_H
@@ -0,0 +1,49 @@
+/**
+ * @file occtshapecache.cpp
+ * @brief Implementation of the OcctShapeCache class
+ */
+
+#include "occtshapecache.h"
+
+#include <QMutexLocker>
+
+OcctShapeCache::OcctShapeCache()
+{
+}
+
+TopoDS_Shape OcctShapeCache::findOrCreate(float innerRadius, float outerRadius, float height,
+                                          const std::function<TopoDS_Shape()>& builder)
+{
+    Key key{innerRadius, outerRadius, height};
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_shapes.constFind(key);
+        if (it != m_shapes.constEnd()) {
+            return it.value();
+        }
+    }
+
+    // Build outside the lock so different rings are built concurrently
+    TopoDS_Shape shape = builder();
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_shapes.constFind(key);
+    if (it != m_shapes.constEnd()) {
+        return it.value();
+    }
+    m_shapes.insert(key, shape);
+    return shape;
+}
+
+void OcctShapeCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_shapes.clear();
+}
+
+int OcctShapeCache::count() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_shapes.size();
+}
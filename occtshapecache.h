@@ -0,0 +1,88 @@
+/**
+ * @file occtshapecache.h
+ * @brief Header file for the OcctShapeCache class
+ */
+
+#ifndef OCCTSHAPECACHE_H
+#define OCCTSHAPECACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <functional>
+
+#include <TopoDS_Shape.hxx>
+
+/**
+ * @class OcctShapeCache
+ * @brief Thread-safe cache of prototype shapes keyed by their dimensions
+ *
+ * Objects with identical dimensions (e.g. all tubes in one radial ring of the
+ * drywell grid) share a single prototype BRep from this cache. Each object then
+ * places the prototype with its own TopLoc_Location, so the number of distinct
+ * BReps grows with the number of distinct dimension triples rather than with
+ * the number of objects.
+ *
+ * The key is the exact (innerRadius, outerRadius, height) triple; callers
+ * building shapes of another kind should use a distinct cache instance.
+ */
+class OcctShapeCache
+{
+public:
+    /**
+     * @brief Default constructor
+     */
+    explicit OcctShapeCache();
+
+    /**
+     * @brief Returns the cached prototype, building it on first use
+     *
+     * Safe to call concurrently. The builder runs without the lock held; if two
+     * threads race on the same key, the first inserted shape wins.
+     *
+     * @param innerRadius Inner radius of the prototype
+     * @param outerRadius Outer radius of the prototype
+     * @param height Height of the prototype
+     * @param builder Function creating the prototype shape at the origin
+     * @return The shared prototype shape
+     */
+    TopoDS_Shape findOrCreate(float innerRadius, float outerRadius, float height,
+                              const std::function<TopoDS_Shape()>& builder);
+
+    /**
+     * @brief Releases all cached prototypes
+     *
+     * Shapes already handed out stay valid; they keep their own reference.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of cached prototypes
+     * @return Number of distinct dimension triples built so far
+     */
+    int count() const;
+
+private:
+    struct Key
+    {
+        float innerRadius;
+        float outerRadius;
+        float height;
+
+        bool operator==(const Key& other) const
+        {
+            return innerRadius == other.innerRadius &&
+                   outerRadius == other.outerRadius &&
+                   height == other.height;
+        }
+
+        friend size_t qHash(const Key& key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.innerRadius, key.outerRadius, key.height);
+        }
+    };
+
+    QHash<Key, TopoDS_Shape> m_shapes;
+    mutable QMutex m_mutex;
+};
+
+#endif // OCCTSHAPECACHE_H
@@ -0,0 +1,169 @@
+/**
+ * @file occttubemesher.cpp
+ * @brief Implementation of the OcctTubeMesher class
+ */
+
+#include "occttubemesher.h"
+
+#include <Poly_Triangle.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pnt.hxx>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+const int kSurfacesPerCell = 4;
+
+// Calls addVertex(point, normal) for every vertex of the cell, surface by
+// surface (outer wall, inner wall, top, bottom), two vertices per segment
+template <typename AddVertex>
+void emitVertices(double ri, double ro, double zb, double zt,
+                  const QVector<double>& cosTable, const QVector<double>& sinTable,
+                  AddVertex addVertex)
+{
+    const int segments = cosTable.size();
+
+    for (int k = 0; k < segments; ++k) {
+        const double c = cosTable[k];
+        const double s = sinTable[k];
+        // Outer wall, normal pointing away from the axis
+        addVertex(gp_Pnt(ro * c, ro * s, zb), gp_Dir(c, s, 0));
+        addVertex(gp_Pnt(ro * c, ro * s, zt), gp_Dir(c, s, 0));
+    }
+    for (int k = 0; k < segments; ++k) {
+        const double c = cosTable[k];
+        const double s = sinTable[k];
+        // Inner wall, normal pointing towards the axis
+        addVertex(gp_Pnt(ri * c, ri * s, zb), gp_Dir(-c, -s, 0));
+        addVertex(gp_Pnt(ri * c, ri * s, zt), gp_Dir(-c, -s, 0));
+    }
+    for (int k = 0; k < segments; ++k) {
+        const double c = cosTable[k];
+        const double s = sinTable[k];
+        // Top face
+        addVertex(gp_Pnt(ri * c, ri * s, zt), gp_Dir(0, 0, 1));
+        addVertex(gp_Pnt(ro * c, ro * s, zt), gp_Dir(0, 0, 1));
+    }
+    for (int k = 0; k < segments; ++k) {
+        const double c = cosTable[k];
+        const double s = sinTable[k];
+        // Bottom face
+        addVertex(gp_Pnt(ri * c, ri * s, zb), gp_Dir(0, 0, -1));
+        addVertex(gp_Pnt(ro * c, ro * s, zb), gp_Dir(0, 0, -1));
+    }
+}
+
+// Calls addTriangle(a, b, c) with vertex indices relative to the first vertex
+// of the cell; triangles are wound counter-clockwise seen from the normal side
+template <typename AddTriangle>
+void emitTriangles(int segments, AddTriangle addTriangle)
+{
+    for (int surface = 0; surface < kSurfacesPerCell; ++surface) {
+        const int first = surface * 2 * segments;
+        const bool flip = (surface == 1 || surface == 2);  // inner wall, top face
+
+        for (int k = 0; k < segments; ++k) {
+            const int next = (k + 1) % segments;
+            const int a = first + 2 * k;
+            const int b = a + 1;
+            const int c = first + 2 * next;
+            const int d = c + 1;
+
+            if (flip) {
+                addTriangle(a, b, c);
+                addTriangle(b, d, c);
+            } else {
+                addTriangle(a, c, b);
+                addTriangle(b, c, d);
+            }
+        }
+    }
+}
+
+} // namespace
+
+OcctTubeMesher::OcctTubeMesher(int angularSegments)
+    : m_angularSegments(qMax(3, angularSegments))
+{
+    updateTables();
+}
+
+void OcctTubeMesher::setAngularSegments(int angularSegments)
+{
+    angularSegments = qMax(3, angularSegments);
+    if (m_angularSegments != angularSegments) {
+        m_angularSegments = angularSegments;
+        updateTables();
+    }
+}
+
+int OcctTubeMesher::getAngularSegments() const
+{
+    return m_angularSegments;
+}
+
+int OcctTubeMesher::verticesPerCell() const
+{
+    return kSurfacesPerCell * 2 * m_angularSegments;
+}
+
+int OcctTubeMesher::trianglesPerCell() const
+{
+    return kSurfacesPerCell * 2 * m_angularSegments;
+}
+
+void OcctTubeMesher::updateTables()
+{
+    m_cos.resize(m_angularSegments);
+    m_sin.resize(m_angularSegments);
+    for (int k = 0; k < m_angularSegments; ++k) {
+        double angle = 2.0 * M_PI * k / m_angularSegments;
+        m_cos[k] = std::cos(angle);
+        m_sin[k] = std::sin(angle);
+    }
+}
+
+Handle(Poly_Triangulation) OcctTubeMesher::triangulate(float innerRadius, float outerRadius,
+                                                       float zBottom, float zTop) const
+{
+    Handle(Poly_Triangulation) triangulation =
+        new Poly_Triangulation(verticesPerCell(), trianglesPerCell(), Standard_False, Standard_True);
+
+    // Poly_Triangulation indices are 1-based
+    int node = 1;
+    emitVertices(innerRadius, outerRadius, zBottom, zTop, m_cos, m_sin,
+                 [&triangulation, &node](const gp_Pnt& point, const gp_Dir& normal) {
+                     triangulation->SetNode(node, point);
+                     triangulation->SetNormal(node, normal);
+                     ++node;
+                 });
+
+    int triangle = 1;
+    emitTriangles(m_angularSegments, [&triangulation, &triangle](int a, int b, int c) {
+        triangulation->SetTriangle(triangle++, Poly_Triangle(a + 1, b + 1, c + 1));
+    });
+
+    return triangulation;
+}
+
+void OcctTubeMesher::appendToArray(const Handle(Graphic3d_ArrayOfTriangles)& array,
+                                   float innerRadius, float outerRadius,
+                                   float zBottom, float zTop,
+                                   const Graphic3d_Vec4ub& color) const
+{
+    // 1-based index of the first vertex of this cell
+    const int base = array->VertexNumber() + 1;
+
+    emitVertices(innerRadius, outerRadius, zBottom, zTop, m_cos, m_sin,
+                 [&array, &color](const gp_Pnt& point, const gp_Dir& normal) {
+                     array->SetVertexColor(array->AddVertex(point, normal), color);
+                 });
+
+    emitTriangles(m_angularSegments, [&array, base](int a, int b, int c) {
+        array->AddTriangleEdges(base + a, base + b, base + c);
+    });
+}
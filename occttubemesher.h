@@ -0,0 +1,88 @@
+/**
+ * @file occttubemesher.h
+ * @brief Header file for the OcctTubeMesher class
+ */
+
+#ifndef OCCTTUBEMESHER_H
+#define OCCTTUBEMESHER_H
+
+#include <QVector>
+
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <Graphic3d_Vec4.hxx>
+#include <Poly_Triangulation.hxx>
+
+/**
+ * @class OcctTubeMesher
+ * @brief Emits the triangulation of an annular cell directly from its dimensions
+ *
+ * For display only triangles are needed, so this bypasses building a BRep with
+ * OcctTubeObject::createShape() and meshing it with BRepMesh. A cell is
+ * tessellated as four surfaces (outer wall, inner wall, top, bottom) with
+ * angularSegments quads each, giving verticesPerCell() vertices and
+ * trianglesPerCell() triangles per cell, in a fixed order.
+ *
+ * BRep solids remain necessary for exact geometry such as STEP export.
+ */
+class OcctTubeMesher
+{
+public:
+    /**
+     * @brief Constructor
+     * @param angularSegments Number of segments around the circumference (at least 3)
+     */
+    explicit OcctTubeMesher(int angularSegments = 24);
+
+    void setAngularSegments(int angularSegments);
+    int getAngularSegments() const;
+
+    /**
+     * @brief Gets the number of vertices emitted per cell
+     */
+    int verticesPerCell() const;
+
+    /**
+     * @brief Gets the number of triangles emitted per cell
+     */
+    int trianglesPerCell() const;
+
+    /**
+     * @brief Builds a standalone triangulation of one cell
+     * @param innerRadius Inner radius
+     * @param outerRadius Outer radius
+     * @param zBottom Z coordinate of the bottom face
+     * @param zTop Z coordinate of the top face
+     * @return Triangulation with per-node normals
+     */
+    Handle(Poly_Triangulation) triangulate(float innerRadius, float outerRadius,
+                                           float zBottom, float zTop) const;
+
+    /**
+     * @brief Appends one cell to a vertex buffer
+     *
+     * The array must have been created with vertex normals and vertex colours
+     * and have room for verticesPerCell() vertices and 3 * trianglesPerCell()
+     * edges. The cell's vertices are contiguous, so its colour can later be
+     * rewritten in place.
+     *
+     * @param array Target triangle array
+     * @param innerRadius Inner radius
+     * @param outerRadius Outer radius
+     * @param zBottom Z coordinate of the bottom face
+     * @param zTop Z coordinate of the top face
+     * @param color Colour assigned to every vertex of the cell
+     */
+    void appendToArray(const Handle(Graphic3d_ArrayOfTriangles)& array,
+                       float innerRadius, float outerRadius,
+                       float zBottom, float zTop,
+                       const Graphic3d_Vec4ub& color) const;
+
+private:
+    void updateTables();
+
+    int m_angularSegments;
+    QVector<double> m_cos;
+    QVector<double> m_sin;
+};
+
+#endif // OCCTTUBEMESHER_H
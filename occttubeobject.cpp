@@ -1,7 +1,14 @@
 #include "occttubeobject.h"
+#include "occtshapecache.h"
+#include "occttubemesher.h"
 
 #include <BRepPrimAPI_MakeCylinder.hxx>
 #include <BRepAlgoAPI_Cut.hxx>
+#include <BRepBuilderAPI_MakePolygon.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepPrimAPI_MakeRevol.hxx>
+#include <TopoDS_Face.hxx>
+#include <gp_Ax1.hxx>
 #include <gp_Ax2.hxx>
 #include <QJsonObject>
 
@@ -10,6 +17,7 @@ OcctTubeObject::OcctTubeObject()
     , m_innerRadius(0.5f)
     , m_outerRadius(1.0f)
     , m_height(2.0f)
+    , m_shapeCache(nullptr)
 {
 }
 
@@ -18,6 +26,7 @@ OcctTubeObject::OcctTubeObject(float innerRadius, float outerRadius, float heigh
     , m_innerRadius(innerRadius)
     , m_outerRadius(outerRadius)
     , m_height(height)
+    , m_shapeCache(nullptr)
 {
 }
 
@@ -34,9 +43,7 @@ void OcctTubeObject::setInnerRadius(float radius)
 {
     if (m_innerRadius != radius) {
         m_innerRadius = radius;
-        if (!getAISShape().IsNull()) {
-            createAISObject();
-        }
+        rebuildShape();
     }
 }
 
@@ -49,9 +56,7 @@ void OcctTubeObject::setOuterRadius(float radius)
 {
     if (m_outerRadius != radius) {
         m_outerRadius = radius;
-        if (!getAISShape().IsNull()) {
-            createAISObject();
-        }
+        rebuildShape();
     }
 }
 
@@ -64,9 +69,7 @@ void OcctTubeObject::setHeight(float height)
 {
     if (m_height != height) {
         m_height = height;
-        if (!getAISShape().IsNull()) {
-            createAISObject();
-        }
+        rebuildShape();
     }
 }
 
@@ -86,26 +89,75 @@ void OcctTubeObject::setDimensions(float innerRadius, float outerRadius, float h
         changed = true;
     }
 
-    if (changed && !getAISShape().IsNull()) {
-        createAISObject();
+    if (changed) {
+        rebuildShape();
     }
 }
 
+Handle(Poly_Triangulation) OcctTubeObject::createTriangulation(int angularSegments) const
+{
+    OcctTubeMesher mesher(angularSegments);
+    return mesher.triangulate(m_innerRadius, m_outerRadius, -m_height / 2.0f, m_height / 2.0f);
+}
+
+void OcctTubeObject::setShapeCache(OcctShapeCache* cache)
+{
+    m_shapeCache = cache;
+}
+
+OcctShapeCache* OcctTubeObject::getShapeCache() const
+{
+    return m_shapeCache;
+}
+
 TopoDS_Shape OcctTubeObject::createShape()
+{
+    if (m_shapeCache) {
+        float innerRadius = m_innerRadius;
+        float outerRadius = m_outerRadius;
+        float height = m_height;
+        return m_shapeCache->findOrCreate(innerRadius, outerRadius, height, [=]() {
+            return makeAnnulus(innerRadius, outerRadius, height);
+        });
+    }
+
+    return makeAnnulus(m_innerRadius, m_outerRadius, m_height);
+}
+
+TopoDS_Shape OcctTubeObject::makeAnnulus(float innerRadius, float outerRadius, float height,
+                                         ConstructionMethod method)
 {
     // Create axis along Z direction, centered at origin
-    gp_Ax2 axis(gp_Pnt(0, 0, -m_height/2.0), gp_Dir(0, 0, 1));
+    gp_Ax2 axis(gp_Pnt(0, 0, -height/2.0), gp_Dir(0, 0, 1));
 
-    // Create outer cylinder
-    TopoDS_Shape outerCylinder = BRepPrimAPI_MakeCylinder(axis, m_outerRadius, m_height).Shape();
+    // A tube without a hole is just a cylinder
+    if (innerRadius <= 0.0f) {
+        return BRepPrimAPI_MakeCylinder(axis, outerRadius, height).Shape();
+    }
 
-    // Create inner cylinder (to be subtracted)
-    TopoDS_Shape innerCylinder = BRepPrimAPI_MakeCylinder(axis, m_innerRadius, m_height).Shape();
+    if (method == BooleanCut) {
+        // Create outer cylinder
+        TopoDS_Shape outerCylinder = BRepPrimAPI_MakeCylinder(axis, outerRadius, height).Shape();
 
-    // Perform Boolean cut operation to create tube
-    TopoDS_Shape tube = BRepAlgoAPI_Cut(outerCylinder, innerCylinder).Shape();
+        // Create inner cylinder (to be subtracted)
+        TopoDS_Shape innerCylinder = BRepPrimAPI_MakeCylinder(axis, innerRadius, height).Shape();
 
-    return tube;
+        // Perform Boolean cut operation to create tube
+        return BRepAlgoAPI_Cut(outerCylinder, innerCylinder).Shape();
+    }
+
+    // Rectangular profile of the tube wall in the XZ half-plane
+    double zBottom = -height / 2.0;
+    double zTop = height / 2.0;
+    BRepBuilderAPI_MakePolygon profile(gp_Pnt(innerRadius, 0, zBottom),
+                                       gp_Pnt(outerRadius, 0, zBottom),
+                                       gp_Pnt(outerRadius, 0, zTop),
+                                       gp_Pnt(innerRadius, 0, zTop),
+                                       Standard_True);
+    TopoDS_Face face = BRepBuilderAPI_MakeFace(profile.Wire(), Standard_True).Face();
+
+    // Full revolution around the Z-axis closes the annular solid
+    return BRepPrimAPI_MakeRevol(face, gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1))).Shape();
 }
 
 QJsonObject OcctTubeObject::toJson() const
@@ -236,6 +288,23 @@ QString OcctTubeObject::getObjectType() const
     return "Tube";
 }
 
+int OcctTubeObject::writeDimensions(float* dimensions) const
+{
+    dimensions[0] = m_innerRadius;
+    dimensions[1] = m_outerRadius;
+    dimensions[2] = m_height;
+    return 3;
+}
+
+bool OcctTubeObject::readDimensions(const float* dimensions, int count)
+{
+    if (count < 3) {
+        return false;
+    }
+    setDimensions(dimensions[0], dimensions[1], dimensions[2]);
+    return true;
+}
+
 // Static registration
 static bool s_occtTubeRegistered = []() {
     OcctGeo3DObject::registerObjectType("Tube", []() -> OcctGeo3DObject* {
@@ -8,17 +8,31 @@
 
 #include "occtgeo3dobject.h"
 
+#include <Poly_Triangulation.hxx>
+
+class OcctShapeCache;
+
 /**
  * @class OcctTubeObject
  * @brief A 3D hollow cylinder (tube) object using OpenCASCADE
  *
  * The OcctTubeObject class creates a tube/pipe shape - essentially a cylinder
  * with another cylinder removed from its center. It's defined by inner radius,
- * outer radius, and height. Created using Boolean operations in OpenCASCADE.
+ * outer radius, and height. By default the annular solid is built directly by
+ * revolving its rectangular r-z profile around the Z-axis; the original
+ * Boolean-cut construction is kept available through makeAnnulus().
  */
 class OcctTubeObject : public OcctGeo3DObject
 {
 public:
+    /**
+     * @brief Strategy used to build the annular solid
+     */
+    enum ConstructionMethod {
+        Revolved,   ///< Revolve the rectangular r-z profile (no Boolean operation)
+        BooleanCut  ///< Outer cylinder minus inner cylinder via BRepAlgoAPI_Cut
+    };
+
     /**
      * @brief Default constructor
      * Creates a tube with default parameters
@@ -50,15 +64,60 @@ public:
 
     void setDimensions(float innerRadius, float outerRadius, float height);
 
+    /**
+     * @brief Triangulates the tube analytically, without building a BRep
+     *
+     * The triangulation is in the tube's local frame (centered at the origin,
+     * like createShape()); see OcctTubeMesher.
+     *
+     * @param angularSegments Number of segments around the circumference
+     * @return Triangulation with per-node normals
+     */
+    Handle(Poly_Triangulation) createTriangulation(int angularSegments = 24) const;
+
+    /**
+     * @brief Shares the tube geometry through a prototype cache
+     *
+     * When set, createShape() takes the annulus from the cache instead of
+     * building a private copy; the object's transform is then applied as a
+     * TopLoc_Location on the shared prototype.
+     *
+     * @param cache Cache to use, or nullptr for a private shape
+     * @note The cache must outlive this object
+     */
+    void setShapeCache(OcctShapeCache* cache);
+    OcctShapeCache* getShapeCache() const;
+
+    /**
+     * @brief Builds an annular solid centered at the origin along the Z-axis
+     *
+     * Both methods yield a closed, valid solid with the same volume. Revolved
+     * avoids the Boolean operation entirely and is the one used by createShape().
+     * If innerRadius is not positive a plain cylinder is returned.
+     *
+     * @param innerRadius Inner radius of the annulus
+     * @param outerRadius Outer radius of the annulus
+     * @param height Height of the annulus (extends from -height/2 to +height/2)
+     * @param method Construction strategy
+     * @return TopoDS_Shape containing the annular solid
+     */
+    static TopoDS_Shape makeAnnulus(float innerRadius, float outerRadius, float height,
+                                    ConstructionMethod method = Revolved);
+
     // JSON Serialization
     QJsonObject toJson() const override;
     bool fromJson(const QJsonObject& json) override;
     QString getObjectType() const override;
 
+    // Binary serialization
+    int writeDimensions(float* dimensions) const override;
+    bool readDimensions(const float* dimensions, int count) override;
+
 protected:
     /**
      * @brief Creates the tube shape using OpenCASCADE
-     * Uses BRepPrimAPI_MakeCylinder and BRepAlgoAPI_Cut to create hollow cylinder
+     * Revolves the r-z profile of the tube wall (see makeAnnulus()), or
+     * returns the shared prototype when a shape cache is set
      * @return TopoDS_Shape containing the tube geometry
      */
     TopoDS_Shape createShape() override;
@@ -67,6 +126,7 @@ private:
     float m_innerRadius;
     float m_outerRadius;
     float m_height;
+    OcctShapeCache* m_shapeCache;
 };
 
 #endif // OCCTTUBEOBJECT_H
@@ -6,11 +6,20 @@
 #include "occtviewer.h"
 #include "occtgeo3dobjectset.h"
 #include "occtcylinderobject.h"
+#include "occtdrywellsystem.h"
+#include "occtfieldanimator.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QLabel>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QSlider>
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QDateTime>
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QShowEvent>
@@ -20,6 +29,8 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
 
 #include <OpenGl_GraphicDriver.hxx>
 #include <TCollection_AsciiString.hxx>
@@ -36,6 +47,15 @@
 #include <Quantity_Color.hxx>
 #include <Graphic3d_Camera.hxx>
 #include <AIS_ViewCube.hxx>
+#include <gp_Pln.hxx>
+#include <Graphic3d_FrameStats.hxx>
+#include <TColStd_IndexedDataMapOfStringString.hxx>
+
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
 
 // ============================================================================
 // OcctViewerWidget Implementation (QWidget-based)
@@ -43,9 +63,16 @@
 
 OcctViewerWidget::OcctViewerWidget(QWidget* parent)
     : QWidget(parent)
+    , m_cutawayAngle(90.0)
+    , m_cutawayOffset(0.0)
+    , m_transparencyMode(PlainBlending)
+    , m_depthPeelingLayers(4)
+    , m_showStatistics(false)
     , m_isRotating(false)
     , m_isPanning(false)
     , m_initialized(false)
+    , m_rotationPending(false)
+    , m_pendingZoom(1.0)
 {
     // These attributes are CRITICAL for native OCCT rendering
     setAttribute(Qt::WA_PaintOnScreen);
@@ -54,6 +81,19 @@ OcctViewerWidget::OcctViewerWidget(QWidget* parent)
     setMinimumSize(400, 300);
     setFocusPolicy(Qt::StrongFocus);
     setMouseTracking(true);
+
+    // At most one redraw per display refresh while interacting
+    m_redrawTimer.setSingleShot(true);
+    m_redrawTimer.setTimerType(Qt::PreciseTimer);
+    m_redrawTimer.setInterval(16);
+    connect(&m_redrawTimer, &QTimer::timeout, this, &OcctViewerWidget::flushInput);
+
+    // Cutaway plane, added to the view once it exists and switched on demand
+    m_clipPlane = new Graphic3d_ClipPlane();
+    m_clipPlane->SetCapping(Standard_True);
+    m_clipPlane->SetCappingColor(Quantity_Color(Quantity_NOC_GRAY70));
+    m_clipPlane->SetOn(Standard_False);
+    updateCutawayEquation();
 }
 
 OcctViewerWidget::~OcctViewerWidget()
@@ -84,8 +124,9 @@ void OcctViewerWidget::initializeOcct()
     m_viewer->SetDefaultLights();
     m_viewer->SetLightOn();
 
-    // Create view
+    // Create view; camera changes are redrawn explicitly, once per tick
     m_view = m_viewer->CreateView();
+    m_view->SetImmediateUpdate(Standard_False);
 
     // Create window handle
 #ifdef _WIN32
@@ -116,6 +157,10 @@ void OcctViewerWidget::initializeOcct()
     m_view->SetProj(V3d_XposYposZpos);
     m_view->FitAll(0.01, Standard_False);
 
+    m_view->AddClipPlane(m_clipPlane);
+    applyTransparencyMode();
+    applyStatisticsParams();
+
     m_initialized = true;
 }
 
@@ -161,12 +206,247 @@ void OcctViewerWidget::fitAll()
     }
 }
 
+void OcctViewerWidget::setCutawayEnabled(bool enabled)
+{
+    m_clipPlane->SetOn(enabled ? Standard_True : Standard_False);
+    update();
+}
+
+bool OcctViewerWidget::isCutawayEnabled() const
+{
+    return m_clipPlane->IsOn();
+}
+
+void OcctViewerWidget::setCutawayPlane(double angleDegrees, double offset)
+{
+    m_cutawayAngle = angleDegrees;
+    m_cutawayOffset = offset;
+    updateCutawayEquation();
+
+    if (isCutawayEnabled()) {
+        update();
+    }
+}
+
+double OcctViewerWidget::getCutawayAngle() const
+{
+    return m_cutawayAngle;
+}
+
+double OcctViewerWidget::getCutawayOffset() const
+{
+    return m_cutawayOffset;
+}
+
+void OcctViewerWidget::updateCutawayEquation()
+{
+    // Vertical plane; the half-space the normal points into stays visible
+    double angle = m_cutawayAngle * M_PI / 180.0;
+    gp_Dir normal(std::cos(angle), std::sin(angle), 0.0);
+    gp_Pnt origin(m_cutawayOffset * normal.X(), m_cutawayOffset * normal.Y(), 0.0);
+    m_clipPlane->SetEquation(gp_Pln(origin, normal));
+}
+
+void OcctViewerWidget::setTransparencyMode(TransparencyMode mode, int depthPeelingLayers)
+{
+    m_transparencyMode = mode;
+    m_depthPeelingLayers = qMax(2, depthPeelingLayers);
+    applyTransparencyMode();
+    update();
+}
+
+OcctViewerWidget::TransparencyMode OcctViewerWidget::getTransparencyMode() const
+{
+    return m_transparencyMode;
+}
+
+int OcctViewerWidget::getDepthPeelingLayers() const
+{
+    return m_depthPeelingLayers;
+}
+
+void OcctViewerWidget::applyTransparencyMode()
+{
+    if (m_view.IsNull()) {
+        return;  // Applied in initializeOcct()
+    }
+
+    Graphic3d_RenderingParams& params = m_view->ChangeRenderingParams();
+    switch (m_transparencyMode) {
+    case WeightedOit:
+        params.TransparencyMethod = Graphic3d_RTM_BLEND_OIT;
+        break;
+    case DepthPeeling:
+        params.TransparencyMethod = Graphic3d_RTM_DEPTH_PEELING_OIT;
+        params.NbOitDepthPeelingLayers = m_depthPeelingLayers;
+        break;
+    case PlainBlending:
+    default:
+        params.TransparencyMethod = Graphic3d_RTM_BLEND_UNORDERED;
+        break;
+    }
+}
+
+double OcctViewerWidget::measureFrameTime(int frames)
+{
+    if (m_view.IsNull()) {
+        return -1.0;
+    }
+
+    frames = qMax(1, frames);
+
+    // Warm-up frame compiles shaders and allocates the OIT buffers
+    m_view->Invalidate();
+    m_view->Redraw();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < frames; ++i) {
+        m_view->Invalidate();
+        m_view->Redraw();
+    }
+
+    return timer.nsecsElapsed() / 1.0e6 / frames;
+}
+
+void OcctViewerWidget::setStatisticsVisible(bool visible)
+{
+    m_showStatistics = visible;
+    applyStatisticsParams();
+    update();
+}
+
+bool OcctViewerWidget::isStatisticsVisible() const
+{
+    return m_showStatistics;
+}
+
+void OcctViewerWidget::applyStatisticsParams()
+{
+    if (m_view.IsNull()) {
+        return;  // Applied in initializeOcct()
+    }
+
+    // Counters are always collected so collectStatistics() works without the overlay
+    Graphic3d_RenderingParams& params = m_view->ChangeRenderingParams();
+    params.CollectedStats = Graphic3d_RenderingParams::PerformanceCounters(
+        Graphic3d_RenderingParams::PerfCounters_FrameRate
+        | Graphic3d_RenderingParams::PerfCounters_CPU
+        | Graphic3d_RenderingParams::PerfCounters_Layers
+        | Graphic3d_RenderingParams::PerfCounters_Structures
+        | Graphic3d_RenderingParams::PerfCounters_Groups
+        | Graphic3d_RenderingParams::PerfCounters_GroupArrays
+        | Graphic3d_RenderingParams::PerfCounters_Triangles
+        | Graphic3d_RenderingParams::PerfCounters_EstimMem
+        | Graphic3d_RenderingParams::PerfCounters_FrameTime);
+    params.ToShowStats = m_showStatistics ? Standard_True : Standard_False;
+}
+
+OcctViewerWidget::RenderStatistics OcctViewerWidget::collectStatistics()
+{
+    RenderStatistics stats;
+    if (m_view.IsNull()) {
+        return stats;
+    }
+
+    // Frame rates are frames over the time since the last published data
+    // frame, which after an idle view is mostly idle time. A frame with a
+    // zero update interval publishes and restarts that timer, then a short
+    // burst of redraws is averaged into the next data frame.
+    Graphic3d_RenderingParams& params = m_view->ChangeRenderingParams();
+    const Standard_ShortReal savedInterval = params.StatsUpdateInterval;
+    params.StatsUpdateInterval = 0.0f;
+    m_view->Invalidate();
+    m_view->Redraw();
+
+    const Handle(Graphic3d_FrameStats)& frameStats = m_view->View()->FrameStats();
+    const Standard_Integer flushedIndex = frameStats->LastDataFrameIndex();
+    params.StatsUpdateInterval = 0.25f;
+
+    // Bounded in case the counters are not collected
+    QElapsedTimer timer;
+    timer.start();
+    while (frameStats->LastDataFrameIndex() == flushedIndex && timer.elapsed() < 2000) {
+        m_view->Invalidate();
+        m_view->Redraw();
+    }
+    params.StatsUpdateInterval = savedInterval;
+
+    const Graphic3d_FrameStatsData& frame = m_view->View()->FrameStats()->LastDataFrame();
+    stats.fps = frame.FrameRate();
+    stats.cpuFps = frame.FrameRateCpu();
+    stats.frameTime = frame.TimerValue(Graphic3d_FrameStatsTimer_ElapsedFrame) * 1000.0;
+    stats.cpuFrameTime = frame.TimerValue(Graphic3d_FrameStatsTimer_CpuFrame) * 1000.0;
+    stats.gpuFrameTime = qMax(0.0, stats.frameTime - stats.cpuFrameTime);
+    stats.triangles = static_cast<qint64>(frame.CounterValue(Graphic3d_FrameStatsCounter_NbTrianglesNotCulled));
+    stats.elements = static_cast<qint64>(frame.CounterValue(Graphic3d_FrameStatsCounter_NbElemsNotCulled));
+    stats.structures = static_cast<qint64>(frame.CounterValue(Graphic3d_FrameStatsCounter_NbStructs));
+    stats.geometryBytes = static_cast<qint64>(frame.CounterValue(Graphic3d_FrameStatsCounter_EstimatedBytesGeom));
+    stats.framebufferBytes = static_cast<qint64>(frame.CounterValue(Graphic3d_FrameStatsCounter_EstimatedBytesFbos));
+    stats.textureBytes = static_cast<qint64>(frame.CounterValue(Graphic3d_FrameStatsCounter_EstimatedBytesTextures));
+
+    if (!m_context.IsNull()) {
+        AIS_ListOfInteractive displayed;
+        m_context->DisplayedObjects(displayed);
+        stats.presentations = displayed.Size();
+    }
+
+    return stats;
+}
+
+QJsonObject OcctViewerWidget::statisticsToJson()
+{
+    RenderStatistics stats = collectStatistics();
+
+    QJsonObject json;
+    json["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    json["width"] = width();
+    json["height"] = height();
+    json["fps"] = stats.fps;
+    json["cpuFps"] = stats.cpuFps;
+    json["frameTimeMs"] = stats.frameTime;
+    json["cpuFrameTimeMs"] = stats.cpuFrameTime;
+    json["gpuFrameTimeMs"] = stats.gpuFrameTime;
+    json["triangles"] = stats.triangles;
+    json["elements"] = stats.elements;
+    json["structures"] = stats.structures;
+    json["presentations"] = stats.presentations;
+    json["geometryBytes"] = stats.geometryBytes;
+    json["framebufferBytes"] = stats.framebufferBytes;
+    json["textureBytes"] = stats.textureBytes;
+
+    // OCCT's own textual report, for anything not covered above
+    if (!m_view.IsNull()) {
+        TColStd_IndexedDataMapOfStringString info;
+        m_view->StatisticInformation(info);
+
+        QJsonObject details;
+        for (TColStd_IndexedDataMapOfStringString::Iterator it(info); it.More(); it.Next()) {
+            details[QString::fromUtf8(it.Key().ToCString())] = QString::fromUtf8(it.Value().ToCString());
+        }
+        json["details"] = details;
+    }
+
+    return json;
+}
+
 void OcctViewerWidget::mousePressEvent(QMouseEvent* event)
 {
+    // Finish the previous gesture before starting a new one
+    if (m_redrawTimer.isActive()) {
+        m_redrawTimer.stop();
+        flushInput();
+    }
+
     m_lastPos = event->pos();
+    m_pressPos = event->pos();
 
     if (event->button() == Qt::LeftButton) {
         m_isRotating = true;
+        if (!m_view.IsNull()) {
+            // Rotation() is relative to this start point, so moves coalesce
+            m_view->StartRotation(m_pressPos.x(), m_pressPos.y());
+        }
     } else if (event->button() == Qt::MiddleButton) {
         m_isPanning = true;
     }
@@ -176,6 +456,11 @@ void OcctViewerWidget::mouseReleaseEvent(QMouseEvent* event)
 {
     if (event->button() == Qt::LeftButton) {
         m_isRotating = false;
+
+        // A click without dragging picks instead of rotating
+        if ((event->pos() - m_pressPos).manhattanLength() < 3) {
+            emit viewClicked(event->pos());
+        }
     } else if (event->button() == Qt::MiddleButton) {
         m_isPanning = false;
     }
@@ -192,12 +477,11 @@ void OcctViewerWidget::mouseMoveEvent(QMouseEvent* event)
     int dy = currPos.y() - m_lastPos.y();
 
     if (m_isRotating) {
-        m_view->StartRotation(m_lastPos.x(), m_lastPos.y());
-        m_view->Rotation(currPos.x(), currPos.y());
-        update();
+        m_rotationPending = true;
+        scheduleRedraw();
     } else if (m_isPanning) {
-        m_view->Pan(dx, -dy);
-        update();
+        m_pendingPan += QPoint(dx, -dy);
+        scheduleRedraw();
     }
 
     m_lastPos = currPos;
@@ -211,12 +495,42 @@ void OcctViewerWidget::wheelEvent(QWheelEvent* event)
 
     int delta = event->angleDelta().y();
     if (delta > 0) {
-        m_view->SetZoom(1.1, Standard_True);
+        m_pendingZoom *= 1.1;
     } else {
-        m_view->SetZoom(0.9, Standard_True);
+        m_pendingZoom *= 0.9;
     }
 
-    update();
+    scheduleRedraw();
+}
+
+void OcctViewerWidget::scheduleRedraw()
+{
+    if (!m_redrawTimer.isActive()) {
+        m_redrawTimer.start();
+    }
+}
+
+void OcctViewerWidget::flushInput()
+{
+    if (m_view.IsNull()) {
+        return;
+    }
+
+    // Apply everything accumulated since the last tick, then draw once
+    if (m_rotationPending) {
+        m_view->Rotation(m_lastPos.x(), m_lastPos.y());
+        m_rotationPending = false;
+    }
+    if (!m_pendingPan.isNull()) {
+        m_view->Pan(m_pendingPan.x(), m_pendingPan.y());
+        m_pendingPan = QPoint();
+    }
+    if (m_pendingZoom != 1.0) {
+        m_view->SetZoom(m_pendingZoom, Standard_True);
+        m_pendingZoom = 1.0;
+    }
+
+    m_view->Redraw();
 }
 
 // ============================================================================
@@ -226,9 +540,21 @@ void OcctViewerWidget::wheelEvent(QWheelEvent* event)
 OcctViewer::OcctViewer(QWidget* parent)
     : QWidget(parent)
     , m_objectSet(nullptr)
+    , m_drywellSystem(nullptr)
+    , m_animator(new OcctFieldAnimator(this))
     , m_viewerWidget(nullptr)
+    , m_infoLabel(nullptr)
+    , m_playButton(nullptr)
+    , m_frameRateSpinBox(nullptr)
+    , m_statsLabel(nullptr)
+    , m_cutawaySlider(nullptr)
+    , m_transparencyComboBox(nullptr)
+    , m_peelingLayersSpinBox(nullptr)
 {
     setupUI();
+
+    connect(m_animator, &OcctFieldAnimator::playingChanged, this, &OcctViewer::onPlayingChanged);
+    connect(m_animator, &OcctFieldAnimator::statisticsChanged, this, &OcctViewer::updatePlaybackStats);
 }
 
 OcctViewer::~OcctViewer()
@@ -244,6 +570,7 @@ void OcctViewer::setupUI()
 
     // Create viewer widget
     m_viewerWidget = new OcctViewerWidget(this);
+    connect(m_viewerWidget, &OcctViewerWidget::viewClicked, this, &OcctViewer::onViewClicked);
     mainLayout->addWidget(m_viewerWidget);
 
     // Create compact button panel
@@ -275,14 +602,97 @@ void OcctViewer::setupUI()
     connect(exportButton, &QPushButton::clicked, this, &OcctViewer::exportToSTEP);
     buttonLayout->addWidget(exportButton);
 
+    // Cutaway view
+    QCheckBox* cutawayCheckBox = new QCheckBox("Cutaway", this);
+    cutawayCheckBox->setMaximumHeight(24);  // Compact height
+    connect(cutawayCheckBox, &QCheckBox::toggled, this, &OcctViewer::setCutaway);
+    buttonLayout->addWidget(cutawayCheckBox);
+
+    m_cutawaySlider = new QSlider(Qt::Horizontal, this);
+    m_cutawaySlider->setRange(0, 359);
+    m_cutawaySlider->setValue(qRound(m_viewerWidget->getCutawayAngle()));
+    m_cutawaySlider->setMaximumWidth(120);  // Limit width
+    m_cutawaySlider->setEnabled(false);
+    connect(m_cutawaySlider, &QSlider::valueChanged, this, &OcctViewer::setCutawayAngle);
+    buttonLayout->addWidget(m_cutawaySlider);
+
+    // Transparency algorithm (order matches OcctViewerWidget::TransparencyMode)
+    m_transparencyComboBox = new QComboBox(this);
+    m_transparencyComboBox->addItem("Blending");
+    m_transparencyComboBox->addItem("Weighted OIT");
+    m_transparencyComboBox->addItem("Depth peeling");
+    m_transparencyComboBox->setMaximumHeight(24);  // Compact height
+    connect(m_transparencyComboBox, &QComboBox::currentIndexChanged,
+            this, &OcctViewer::setTransparencyMode);
+    buttonLayout->addWidget(m_transparencyComboBox);
+
+    m_peelingLayersSpinBox = new QSpinBox(this);
+    m_peelingLayersSpinBox->setRange(2, 16);
+    m_peelingLayersSpinBox->setValue(m_viewerWidget->getDepthPeelingLayers());
+    m_peelingLayersSpinBox->setSuffix(" layers");
+    m_peelingLayersSpinBox->setMaximumHeight(24);  // Compact height
+    m_peelingLayersSpinBox->setEnabled(false);
+    connect(m_peelingLayersSpinBox, &QSpinBox::valueChanged, this, [this](int) {
+        setTransparencyMode(m_transparencyComboBox->currentIndex());
+    });
+    buttonLayout->addWidget(m_peelingLayersSpinBox);
+
+    QPushButton* benchmarkButton = new QPushButton("Benchmark", this);
+    benchmarkButton->setMaximumWidth(90);  // Limit width
+    benchmarkButton->setMaximumHeight(24);  // Compact height
+    connect(benchmarkButton, &QPushButton::clicked, this, &OcctViewer::benchmarkTransparencyModes);
+    buttonLayout->addWidget(benchmarkButton);
+
+    // Render statistics
+    QCheckBox* statsCheckBox = new QCheckBox("Stats", this);
+    statsCheckBox->setMaximumHeight(24);  // Compact height
+    connect(statsCheckBox, &QCheckBox::toggled, m_viewerWidget, &OcctViewerWidget::setStatisticsVisible);
+    buttonLayout->addWidget(statsCheckBox);
+
+    QPushButton* dumpStatsButton = new QPushButton("Dump Stats", this);
+    dumpStatsButton->setMaximumWidth(90);  // Limit width
+    dumpStatsButton->setMaximumHeight(24);  // Compact height
+    connect(dumpStatsButton, &QPushButton::clicked, this, &OcctViewer::dumpStatistics);
+    buttonLayout->addWidget(dumpStatsButton);
+
+    // Time-series playback
+    m_playButton = new QPushButton("Play", this);
+    m_playButton->setMaximumWidth(60);  // Limit width
+    m_playButton->setMaximumHeight(24);  // Compact height
+    connect(m_playButton, &QPushButton::clicked, m_animator, &OcctFieldAnimator::togglePlay);
+    buttonLayout->addWidget(m_playButton);
+
+    QPushButton* stepButton = new QPushButton("Step", this);
+    stepButton->setMaximumWidth(60);  // Limit width
+    stepButton->setMaximumHeight(24);  // Compact height
+    connect(stepButton, &QPushButton::clicked, m_animator, &OcctFieldAnimator::stepForward);
+    buttonLayout->addWidget(stepButton);
+
+    m_frameRateSpinBox = new QSpinBox(this);
+    m_frameRateSpinBox->setRange(1, 120);
+    m_frameRateSpinBox->setValue(qRound(m_animator->getFrameRate()));
+    m_frameRateSpinBox->setSuffix(" fps");
+    m_frameRateSpinBox->setMaximumHeight(24);  // Compact height
+    connect(m_frameRateSpinBox, &QSpinBox::valueChanged, this, [this](int framesPerSecond) {
+        m_animator->setFrameRate(framesPerSecond);
+    });
+    buttonLayout->addWidget(m_frameRateSpinBox);
+
     buttonLayout->addStretch();
 
-    QLabel* infoLabel = new QLabel("L: Rotate | M: Pan | Wheel: Zoom", this);
-    QFont smallFont = infoLabel->font();
+    m_statsLabel = new QLabel(this);
+    QFont statsFont = m_statsLabel->font();
+    statsFont.setPointSize(8);  // Smaller font
+    m_statsLabel->setFont(statsFont);
+    m_statsLabel->setMaximumHeight(24);
+    buttonLayout->addWidget(m_statsLabel);
+
+    m_infoLabel = new QLabel("L: Rotate | M: Pan | Wheel: Zoom", this);
+    QFont smallFont = m_infoLabel->font();
     smallFont.setPointSize(8);  // Smaller font
-    infoLabel->setFont(smallFont);
-    infoLabel->setMaximumHeight(24);
-    buttonLayout->addWidget(infoLabel);
+    m_infoLabel->setFont(smallFont);
+    m_infoLabel->setMaximumHeight(24);
+    buttonLayout->addWidget(m_infoLabel);
 
     mainLayout->addLayout(buttonLayout);
 }
@@ -297,6 +707,22 @@ OcctGeo3DObjectSet* OcctViewer::getObjectSet() const
     return m_objectSet;
 }
 
+void OcctViewer::setDrywellSystem(OcctDrywellSystem* drywellSystem)
+{
+    m_drywellSystem = drywellSystem;
+    m_animator->setDrywellSystem(drywellSystem);
+}
+
+OcctDrywellSystem* OcctViewer::getDrywellSystem() const
+{
+    return m_drywellSystem;
+}
+
+OcctFieldAnimator* OcctViewer::getFieldAnimator() const
+{
+    return m_animator;
+}
+
 Handle(AIS_InteractiveContext) OcctViewer::getContext() const
 {
     if (!m_viewerWidget) {
@@ -320,7 +746,11 @@ void OcctViewer::showObjects()
     context->RemoveAll(Standard_False);
 
     // Display objects from set
-    if (!m_objectSet || m_objectSet->isEmpty()) {
+    if (m_drywellSystem) {
+        // One batched presentation for the whole grid
+        m_drywellSystem->displayGridInContext(context);
+        m_animator->setContext(context);
+    } else if (!m_objectSet || m_objectSet->isEmpty()) {
         // Create demo objects
         OcctGeo3DObjectSet* demoSet = new OcctGeo3DObjectSet();
 
@@ -352,8 +782,12 @@ void OcctViewer::showObjects()
         // Clean up demo set
         delete demoSet;
     } else {
-        // Display provided object set
+        // Tessellate up front on all cores, then display the provided object set
+        m_objectSet->meshAll();
         m_objectSet->displayAll(context);
+        m_infoLabel->setText(QString("Mesh: %1 ms | Display: %2 ms")
+                                 .arg(m_objectSet->getLastMeshTime())
+                                 .arg(m_objectSet->getLastDisplayTime()));
     }
 
     // Update viewer and fit all
@@ -362,6 +796,145 @@ void OcctViewer::showObjects()
     m_viewerWidget->update();
 }
 
+void OcctViewer::onViewClicked(const QPoint& pos)
+{
+    if (!m_drywellSystem || !m_viewerWidget) {
+        return;
+    }
+
+    Handle(AIS_InteractiveContext) context = m_viewerWidget->getContext();
+    Handle(V3d_View) view = m_viewerWidget->getView();
+    if (context.IsNull() || view.IsNull()) {
+        return;
+    }
+
+    context->MoveTo(pos.x(), pos.y(), view, Standard_True);
+
+    OcctGridPresentation::CellId cell;
+    if (m_drywellSystem->getGridPresentation()->detectedCell(context, cell)) {
+        QString zoneName = (cell.zone == OcctGridPresentation::AggregateZone)
+                               ? "Aggregate" : "Below-well";
+        m_infoLabel->setText(QString("%1 cell r=%2 z=%3")
+                                 .arg(zoneName)
+                                 .arg(cell.radialIndex)
+                                 .arg(cell.verticalIndex));
+    } else {
+        m_infoLabel->setText("L: Rotate | M: Pan | Wheel: Zoom");
+    }
+}
+
+void OcctViewer::onPlayingChanged(bool playing)
+{
+    m_playButton->setText(playing ? "Pause" : "Play");
+}
+
+void OcctViewer::updatePlaybackStats()
+{
+    OcctFieldAnimator::Statistics stats = m_animator->getStatistics();
+    m_statsLabel->setText(QString("Frame %1/%2 | %3 fps | apply %4 ms | prepare %5 ms | stalls %6")
+                              .arg(stats.frame + 1)
+                              .arg(stats.frameCount)
+                              .arg(stats.fps, 0, 'f', 1)
+                              .arg(stats.applyTime, 0, 'f', 2)
+                              .arg(stats.prepareTime, 0, 'f', 2)
+                              .arg(stats.stalls));
+}
+
+void OcctViewer::setCutaway(bool enabled)
+{
+    Handle(AIS_InteractiveContext) context = m_viewerWidget->getContext();
+
+    // The plane replaces transparency for seeing inside the grid. Only the
+    // displayed source saves and restores opacities: the object set shares
+    // the drywell's well cylinders, and two owners would restore each other's
+    // forced 1.0
+    if (m_drywellSystem) {
+        m_drywellSystem->setOpaque(enabled, context);
+    } else if (m_objectSet) {
+        m_objectSet->setOpaque(enabled);
+    }
+
+    m_viewerWidget->setCutawayEnabled(enabled);
+    m_cutawaySlider->setEnabled(enabled);
+
+    if (!context.IsNull()) {
+        context->UpdateCurrentViewer();
+    }
+}
+
+void OcctViewer::setCutawayAngle(int angleDegrees)
+{
+    m_viewerWidget->setCutawayPlane(angleDegrees, m_viewerWidget->getCutawayOffset());
+}
+
+void OcctViewer::setTransparencyMode(int index)
+{
+    auto mode = static_cast<OcctViewerWidget::TransparencyMode>(index);
+    m_viewerWidget->setTransparencyMode(mode, m_peelingLayersSpinBox->value());
+    m_peelingLayersSpinBox->setEnabled(mode == OcctViewerWidget::DepthPeeling);
+
+    // Frame timing blocks the GUI thread, so it is left to the Benchmark button
+    m_infoLabel->setText(QString("Transparency: %1").arg(m_transparencyComboBox->currentText()));
+}
+
+void OcctViewer::benchmarkTransparencyModes()
+{
+    if (m_viewerWidget->getView().IsNull()) {
+        return;
+    }
+
+    OcctViewerWidget::TransparencyMode savedMode = m_viewerWidget->getTransparencyMode();
+    int layers = m_peelingLayersSpinBox->value();
+
+    // Same scene and camera for every mode
+    QString report;
+    for (int index = 0; index < m_transparencyComboBox->count(); ++index) {
+        m_viewerWidget->setTransparencyMode(static_cast<OcctViewerWidget::TransparencyMode>(index), layers);
+        double frameTime = m_viewerWidget->measureFrameTime(60);
+        report += QString("%1: %2 ms/frame (%3 fps)\n")
+                      .arg(m_transparencyComboBox->itemText(index))
+                      .arg(frameTime, 0, 'f', 2)
+                      .arg(frameTime > 0.0 ? 1000.0 / frameTime : 0.0, 0, 'f', 1);
+    }
+
+    m_viewerWidget->setTransparencyMode(savedMode, layers);
+
+    QMessageBox::information(this, "Transparency Benchmark",
+                             QString("Average full redraw of the current scene:\n\n%1"
+                                     "\nDepth peeling uses %2 layers.").arg(report).arg(layers));
+}
+
+void OcctViewer::dumpStatistics()
+{
+    if (m_viewerWidget->getView().IsNull()) {
+        QMessageBox::warning(this, "Dump Stats", "No view available.");
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        "Dump Render Statistics",
+        QDir::homePath() + "/render_stats.json",
+        "JSON Files (*.json);;All Files (*)"
+        );
+
+    if (fileName.isEmpty()) {
+        return;  // User cancelled
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        QMessageBox::critical(this, "Dump Stats",
+                              QString("Failed to open file for writing:\n%1").arg(fileName));
+        return;
+    }
+
+    file.write(QJsonDocument(m_viewerWidget->statisticsToJson()).toJson());
+    file.close();
+
+    m_infoLabel->setText(QString("Stats written to %1").arg(QFileInfo(fileName).fileName()));
+}
+
 void OcctViewer::fitAll()
 {
     if (m_viewerWidget) {
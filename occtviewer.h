@@ -9,15 +9,24 @@
 #define OCCTVIEWER_QWIDGET_H
 
 #include <QWidget>
+#include <QTimer>
+#include <QJsonObject>
 
 #include <AIS_InteractiveContext.hxx>
 #include <V3d_View.hxx>
 #include <V3d_Viewer.hxx>
 #include <Aspect_DisplayConnection.hxx>
+#include <Graphic3d_ClipPlane.hxx>
 
 class OcctGeo3DObjectSet;
+class OcctDrywellSystem;
+class OcctFieldAnimator;
 class QPushButton;
 class QLabel;
+class QSpinBox;
+class QCheckBox;
+class QSlider;
+class QComboBox;
 
 /**
  * @class OcctViewerWidget
@@ -28,6 +37,34 @@ class OcctViewerWidget : public QWidget
     Q_OBJECT
 
 public:
+    /**
+     * @brief Algorithms for drawing transparent objects
+     */
+    enum TransparencyMode {
+        PlainBlending,    // Unordered blending, fastest, order artifacts
+        WeightedOit,      // Weighted blended order-independent transparency
+        DepthPeeling      // Depth peeling OIT, exact up to the layer count, slowest
+    };
+
+    /**
+     * @brief Render statistics averaged over a short burst, see collectStatistics()
+     */
+    struct RenderStatistics
+    {
+        double fps = 0.0;
+        double cpuFps = 0.0;            // Frame rate if only CPU time counted
+        double frameTime = 0.0;         // Elapsed frame time in ms
+        double cpuFrameTime = 0.0;      // CPU time of the frame in ms
+        double gpuFrameTime = 0.0;      // frameTime - cpuFrameTime (estimate)
+        qint64 triangles = 0;           // Triangles drawn (not culled)
+        qint64 elements = 0;            // Primitive arrays drawn
+        qint64 structures = 0;          // Graphic structures in the view
+        int presentations = 0;          // Displayed AIS objects
+        qint64 geometryBytes = 0;       // Estimated GPU memory of vertex buffers
+        qint64 framebufferBytes = 0;
+        qint64 textureBytes = 0;
+    };
+
     explicit OcctViewerWidget(QWidget* parent = nullptr);
     ~OcctViewerWidget();
 
@@ -35,6 +72,85 @@ public:
     Handle(V3d_View) getView() const;
     void fitAll();
 
+    /**
+     * @brief Enables the cutaway view
+     *
+     * A capped Graphic3d_ClipPlane slices the scene along a vertical plane
+     * through the well axis, so the inside of the grid can be seen without
+     * transparency. Moving the plane only changes its equation; no geometry
+     * or presentation is rebuilt.
+     *
+     * @param enabled true to slice the scene
+     */
+    void setCutawayEnabled(bool enabled);
+    bool isCutawayEnabled() const;
+
+    /**
+     * @brief Positions the cutaway plane
+     * @param angleDegrees Direction of the plane normal around the Z axis
+     * @param offset Distance of the plane from the Z axis along its normal
+     */
+    void setCutawayPlane(double angleDegrees, double offset = 0.0);
+    double getCutawayAngle() const;
+    double getCutawayOffset() const;
+
+    /**
+     * @brief Selects how transparent objects are composited
+     *
+     * Sets Graphic3d_RenderingParams::TransparencyMethod (and the number of
+     * peeling layers for DepthPeeling) on the view.
+     *
+     * @param mode Transparency algorithm
+     * @param depthPeelingLayers Layers peeled by DepthPeeling (at least 2)
+     */
+    void setTransparencyMode(TransparencyMode mode, int depthPeelingLayers = 4);
+    TransparencyMode getTransparencyMode() const;
+    int getDepthPeelingLayers() const;
+
+    /**
+     * @brief Measures the average time of a full redraw of the current scene
+     *
+     * Redraws the invalidated view the given number of times after one
+     * warm-up frame. With vertical sync enabled in the driver the result is
+     * capped by the display refresh rate.
+     *
+     * @param frames Number of measured frames
+     * @return Milliseconds per frame, or -1 if the view is not initialized
+     */
+    double measureFrameTime(int frames = 30);
+
+    /**
+     * @brief Shows OCCT's frame statistics overlay in the view
+     *
+     * Enables Graphic3d_RenderingParams::ToShowStats with frame rate, CPU
+     * time, layer/structure/group/triangle counters and estimated memory.
+     *
+     * @param visible true to show the overlay
+     */
+    void setStatisticsVisible(bool visible);
+    bool isStatisticsVisible() const;
+
+    /**
+     * @brief Redraws for about a quarter of a second and reads the averaged statistics
+     *
+     * Time the view spent idle before the call is excluded, so the frame
+     * rates are comparable between runs. OCCT does not query GPU timers, so
+     * the GPU time is estimated as the elapsed frame time minus the CPU time.
+     */
+    RenderStatistics collectStatistics();
+
+    /**
+     * @brief Gets collectStatistics() plus V3d_View::StatisticInformation() as JSON
+     */
+    QJsonObject statisticsToJson();
+
+signals:
+    /**
+     * @brief Emitted on a left click that did not rotate the view
+     * @param pos Click position in widget coordinates
+     */
+    void viewClicked(const QPoint& pos);
+
 protected:
     void showEvent(QShowEvent* event) override;
     void paintEvent(QPaintEvent* event) override;
@@ -47,18 +163,41 @@ protected:
 
     QPaintEngine* paintEngine() const override;
 
+private slots:
+    void flushInput();
+
 private:
     void initializeOcct();
+    void scheduleRedraw();
+    void updateCutawayEquation();
+    void applyTransparencyMode();
+    void applyStatisticsParams();
 
     Handle(V3d_Viewer) m_viewer;
     Handle(V3d_View) m_view;
     Handle(AIS_InteractiveContext) m_context;
     Handle(Aspect_DisplayConnection) m_displayConnection;
 
+    // Cutaway
+    Handle(Graphic3d_ClipPlane) m_clipPlane;
+    double m_cutawayAngle;
+    double m_cutawayOffset;
+
+    TransparencyMode m_transparencyMode;
+    int m_depthPeelingLayers;
+    bool m_showStatistics;
+
     QPoint m_lastPos;
+    QPoint m_pressPos;
     bool m_isRotating;
     bool m_isPanning;
     bool m_initialized;
+
+    // Input accumulated between redraw ticks, applied by flushInput()
+    QTimer m_redrawTimer;
+    bool m_rotationPending;
+    QPoint m_pendingPan;
+    double m_pendingZoom;
 };
 
 /**
@@ -76,6 +215,28 @@ public:
     void setObjectSet(OcctGeo3DObjectSet* objectSet);
     OcctGeo3DObjectSet* getObjectSet() const;
 
+    /**
+     * @brief Sets a drywell system to display as one batched grid presentation
+     *
+     * When set, "Show Objects" displays the system through
+     * OcctDrywellSystem::displayGridInContext() instead of one AIS object per
+     * tube, and clicking a cell reports its zone and indices.
+     *
+     * @param drywellSystem The drywell system, or nullptr (not owned)
+     */
+    void setDrywellSystem(OcctDrywellSystem* drywellSystem);
+    OcctDrywellSystem* getDrywellSystem() const;
+
+    /**
+     * @brief Gets the animator that plays time series through the drywell grid
+     *
+     * Give it a time series with OcctFieldAnimator::setTimeSeries(); the
+     * play/pause and step buttons and the frame rate box drive it.
+     *
+     * @return The viewer's animator (owned by the viewer)
+     */
+    OcctFieldAnimator* getFieldAnimator() const;
+
     Handle(AIS_InteractiveContext) getContext() const;
 
 private slots:
@@ -83,12 +244,29 @@ private slots:
     void fitAll();
     void saveImage();
     void exportToSTEP();
+    void onViewClicked(const QPoint& pos);
+    void onPlayingChanged(bool playing);
+    void updatePlaybackStats();
+    void setCutaway(bool enabled);
+    void setCutawayAngle(int angleDegrees);
+    void setTransparencyMode(int index);
+    void benchmarkTransparencyModes();
+    void dumpStatistics();
 
 private:
     void setupUI();
 
     OcctGeo3DObjectSet* m_objectSet;
+    OcctDrywellSystem* m_drywellSystem;
+    OcctFieldAnimator* m_animator;
     OcctViewerWidget* m_viewerWidget;
+    QLabel* m_infoLabel;
+    QPushButton* m_playButton;
+    QSpinBox* m_frameRateSpinBox;
+    QLabel* m_statsLabel;
+    QSlider* m_cutawaySlider;
+    QComboBox* m_transparencyComboBox;
+    QSpinBox* m_peelingLayersSpinBox;
 };
 
 #endif // OCCTVIEWER_QWIDGET_H